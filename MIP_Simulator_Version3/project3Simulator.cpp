@@ -6,7 +6,8 @@
 /Email:     mmuktar1@umbc.edu
 /
 /Description: This program simulates MIPS pipline instructions
-/             (multi stage EX stage)
+/             (multi stage EX stage, the pipelines of version 1 and 2 are
+/             selected with -version)
 /
 /---------------------------------------------------------------------------*/
 
@@ -18,325 +19,665 @@
 #include <tuple>
 #include <iomanip>
 #include <algorithm>
+#include <cstdint>
+#include <chrono>
+#include <array>
+#include <sstream>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <cstddef>
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+#include <type_traits>
+#include <unordered_map>
+#include <memory>
+#include <unordered_set>
+#include <filesystem>
+#include <cerrno>
+#include <random>
+
+//Native translation of the functional mode is only built for x86-64 linux
+#if defined(__x86_64__) && defined(__linux__)
+#define NATIVE_TRANSLATION
+#include <sys/mman.h>
+#endif
+
+//Source files are mapped into memory on systems with mmap
+#if defined(__unix__) || defined(__APPLE__)
+#define MAPPED_FILES
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+//Sampling windows run in forked children on systems with fork
+#if defined(__unix__) || defined(__APPLE__)
+#define FORKED_SAMPLES
+#include <sys/wait.h>
+#include <poll.h>
+#endif
+
+//Lane kernels of the lockstep mode are also built for AVX2, the loader picks
+//the build the CPU supports
+#if defined(__x86_64__) && defined(__linux__) && defined(__GNUC__)
+#define LANE_KERNEL __attribute__((target_clones("avx2", "default")))
+#else
+#define LANE_KERNEL
+#endif
 
 using namespace std;
 
-//Vector used to store opcodes and functions for instructions
-typedef vector<tuple<string, string, string>> R_instructions;
-R_instructions R_INSTRUCTION_LIST;
+//Register index of each name after the $, keyed by its first two characters
+//(the second is 0 for one character names), -1 for names that do not exist
+typedef array<int8_t, 128 * 128> registerTable;
 
-typedef vector<tuple<string, string>> I_instructions;
-I_instructions I_INSTRUCTION_LIST;
+typedef unordered_map<string, int> labelIndex;
 
-//Vector represents register names with their index
-typedef vector<tuple<string, int>> registerIndex;
-registerIndex LIST_REG_INDEX;
+//Operations performed by the ALU
+enum ALU_OP : uint8_t { ALU_ADD, ALU_SUB, ALU_AND, ALU_OR, ALU_SLL, ALU_SRL, ALU_MULT };
 
-typedef vector<tuple<string, int>> labelIndex;
-labelIndex INST_LABEL_INDEX;
+//Bits of the packed control word
+const uint16_t CTRL_REG_DST = 1 << 0, CTRL_ALU_SRC = 1 << 1, CTRL_MEM_TO_REG = 1 << 2
+        , CTRL_REG_WRITE = 1 << 3, CTRL_MEM_READ = 1 << 4, CTRL_MEM_WRITE = 1 << 5
+        , CTRL_BRANCH_BEQ = 1 << 6, CTRL_BRANCH_BNE = 1 << 7, CTRL_JUMP = 1 << 8
+        , CTRL_ZERO_EXTEND = 1 << 9, CTRL_HALT = 1 << 10;
 
-typedef vector<tuple<string, int>> label;
-label instructionLabelIndex;
+//Control words shared by instruction groups
+const uint16_t CTRL_R_TYPE = CTRL_REG_DST | CTRL_REG_WRITE;
+const uint16_t CTRL_I_TYPE = CTRL_ALU_SRC | CTRL_REG_WRITE;
 
-//Vector to store data memory and instruction memory
-vector<string> list_0x00;
-vector<string> list_0x100;
+//Instruction formats used by the assembler
+enum INST_FORMAT { FORMAT_R, FORMAT_I, FORMAT_J, FORMAT_HALT };
 
-//vector to track stage clocks
-vector<int> trackIFClock;
-vector<int> trackIDClock;
-vector<int> trackEXClock;
-vector<int> trackMEMClock;
-vector<int> trackWBClock;
+//Row of the instruction table, name - format - opcode - funct - controls
+//alu operation - IU stage that performs the alu operation
+struct INSTRUCTION_INFO{
 
-//tracks index for clock tracking
-int trackIndex = 0;
+    const char *name;
+    INST_FORMAT format;
+    uint8_t opcode;
+    uint8_t funct;
+    uint16_t control;
+    ALU_OP aluOp;
+    uint8_t executeStage;
 
-//registers stored in array
-int registers[32];
+};
 
-//index indicating index of register
-const int INDEX_V = 2, INDEX_A = 4, INDEX_T0 = 8, INDEX_S = 16
-                    , INDEX_T8 = 24, INDEX_K = 26;
+//Instructions supported by the simulator, adding an instruction is one row
+constexpr INSTRUCTION_INFO INSTRUCTION_TABLE[] = {
+
+    {"ADD",   FORMAT_R,    0x00, 0x20, CTRL_R_TYPE, ALU_ADD,  2},
+    {"SUB",   FORMAT_R,    0x00, 0x22, CTRL_R_TYPE, ALU_SUB,  2},
+    {"AND",   FORMAT_R,    0x00, 0x24, CTRL_R_TYPE, ALU_AND,  1},
+    {"OR",    FORMAT_R,    0x00, 0x25, CTRL_R_TYPE, ALU_OR,   1},
+    {"SLL",   FORMAT_R,    0x00, 0x00, CTRL_R_TYPE, ALU_SLL,  1},
+    {"SRL",   FORMAT_R,    0x00, 0x02, CTRL_R_TYPE, ALU_SRL,  1},
+    {"MULT",  FORMAT_R,    0x00, 0x18, CTRL_R_TYPE, ALU_MULT, 3},
 
-//represents pipline stages with numbers
-const int FETCH = 1, DECODE = 2, EXECUTE_1 = 3, EXECUTE_2 = 4, EXECUTE_3 = 5
-        , ACCESS = 6, WRITE_BACK = 7;
+    {"LW",    FORMAT_I,    0x23, 0x00, CTRL_I_TYPE | CTRL_MEM_TO_REG | CTRL_MEM_READ, ALU_ADD, 1},
+    {"SW",    FORMAT_I,    0x2B, 0x00, CTRL_ALU_SRC | CTRL_MEM_TO_REG | CTRL_MEM_WRITE, ALU_ADD, 1},
+    {"LI",    FORMAT_I,    0x0B, 0x00, CTRL_I_TYPE, ALU_ADD,  1},
+    {"ADDI",  FORMAT_I,    0x08, 0x00, CTRL_I_TYPE, ALU_ADD,  2},
+    {"SUBI",  FORMAT_I,    0x21, 0x00, CTRL_I_TYPE, ALU_SUB,  2},
+    {"ANDI",  FORMAT_I,    0x0C, 0x00, CTRL_I_TYPE | CTRL_ZERO_EXTEND, ALU_AND, 1},
+    {"ORI",   FORMAT_I,    0x0D, 0x00, CTRL_I_TYPE | CTRL_ZERO_EXTEND, ALU_OR, 1},
+    {"BEQ",   FORMAT_I,    0x04, 0x00, CTRL_BRANCH_BEQ, ALU_SUB, 1},
+    {"BNE",   FORMAT_I,    0x05, 0x00, CTRL_BRANCH_BNE, ALU_SUB, 1},
+    {"SLLI",  FORMAT_I,    0x12, 0x00, CTRL_I_TYPE, ALU_SLL,  1},
+    {"SRLI",  FORMAT_I,    0x03, 0x00, CTRL_I_TYPE, ALU_SRL,  1},
+    {"MULTI", FORMAT_I,    0x09, 0x00, CTRL_I_TYPE, ALU_MULT, 3},
 
-int PC = 0;
-bool pcSrc = 0;
-bool ifFlush = 0;
-int clockCycle = 1;
+    {"J",     FORMAT_J,    0x02, 0x00, CTRL_JUMP, ALU_ADD, 1},
+    {"HLT",   FORMAT_HALT, 0x3F, 0x00, CTRL_HALT, ALU_ADD, 1}
 
-string instructionFile;
-string outputFile;
-ofstream outInst;
+};
 
-//variables to hold varaiables for write output
-bool writtenHeader = 0; 
-bool firstFlush = 0;
-bool finishedInst = 0;
-int holdAddress = 0;
-int holdPrevPC = 0;
-int prevPC = 0;
+//Controls produced for an instruction
+struct CONTROL{
 
-//vector to queue stages for pipline
-typedef vector<tuple<int, int>> Queue;
-Queue queueInstructions;
+    uint16_t control = 0;
+    ALU_OP aluOp = ALU_ADD;
+    uint8_t executeStage = 0;
+
+};
+
+//Control table holds opcodes at 0-63 and r-type functs at 64-127
+typedef array<CONTROL, 128> controlTable;
 
 //Precondition:     N/A
-//Post condition:   Parses instruction file inserting into instruction memory  
-void loadInstruction(string filename);
+//Post condition:   Returns the control table built from INSTRUCTION_TABLE
+constexpr controlTable makeControlTable(){
+
+    controlTable table = {};
+
+    for (const INSTRUCTION_INFO &info : INSTRUCTION_TABLE) {
+
+        int index = info.opcode;
+
+        //r-type instructions are found by funct
+        if (info.format == FORMAT_R)
+            index = 64 + info.funct;
+
+        table[index].control = info.control;
+        table[index].aluOp = info.aluOp;
+        table[index].executeStage = info.executeStage;
+
+    }
+
+    return table;
+}
+
+constexpr controlTable CONTROL_TABLE = makeControlTable();
 
 //Precondition:     N/A
-//Post condition:   Stores data file into data memory
-void loadData(string filename);
+//Post condition:   Returns the controls for an opcode and funct
+constexpr const CONTROL &controlFor(int opcode, int funct){
+
+    if (opcode == 0)
+        return CONTROL_TABLE[64 + funct];
+
+    return CONTROL_TABLE[opcode];
+}
+
+//Instruction fields and controls decoded once when instructions are loaded
+struct DECODED_INST{
+
+    uint32_t instruction = 0;
+    bool halt = 0;
+
+    //register fields passed down the pipline
+    int rs = 0, rt = 0, rd = 0;
+
+    //constant/address extended to 32 bits
+    int32_t instrutction15_0 = 0;
+
+    int nextAddress = 0;
+    int jumpAddress = 0;
+
+    CONTROL control;
+
+};
+
+//Computed goto is used for threaded code when the compiler supports it,
+//otherwise the handlers are dispatched with a switch
+#if defined(__GNUC__)
+#define THREADED_DISPATCH
+#endif
+
+//Handlers of the threaded code, r-type and immediate alu handlers follow
+//the order of ALU_OP
+enum THREADED_OP { OP_ADD, OP_SUB, OP_AND, OP_OR, OP_SLL, OP_SRL, OP_MULT
+                , OP_ADDI, OP_SUBI, OP_ANDI, OP_ORI, OP_SLLI, OP_SRLI, OP_MULTI
+                , OP_LW, OP_SW, OP_BEQ, OP_BNE, OP_J, OP_NOP, OP_HLT };
+
+//Instruction translated for the functional mode, operands are extracted and
+//branch targets point at their threaded instruction
+struct THREADED_INST{
+
+    const void *handler = nullptr;
+    THREADED_OP op = OP_HLT;
+
+    uint8_t rs = 0, rt = 0, rd = 0;
+    int32_t immediate = 0;
+
+    const THREADED_INST *target = nullptr;
+
+};
+
+//Word address of the first word of a data file
+const uint32_t DATA_BASE = 256;
+
+//Words in a 4 KiB page, pages in a page table and page tables in the
+//directory, together covering every 32 bit word address
+const int PAGE_BITS = 10, TABLE_BITS = 11;
+const int PAGE_WORDS = 1 << PAGE_BITS;
+const int TABLE_PAGES = 1 << TABLE_BITS;
+const int DIRECTORY_TABLES = 1 << (32 - PAGE_BITS - TABLE_BITS);
+
+//Sparse memory of the whole 32 bit word address space, a page is allocated
+//the first time it is written and reads as zero before then
+class PagedMemory{
+
+public:
+
+    //Precondition:     N/A
+    //Post condition:   Every page is the shared zero page
+    PagedMemory();
+
+    PagedMemory(const PagedMemory &) = delete;
+    PagedMemory &operator=(const PagedMemory &) = delete;
+
+    //Precondition:     N/A
+    //Post condition:   Returns the word at address
+    uint32_t read(uint32_t address) const {
+        return directory[address >> (PAGE_BITS + TABLE_BITS)]
+                [(address >> PAGE_BITS) & (TABLE_PAGES - 1)][address & (PAGE_WORDS - 1)];
+    }
+
+    //Precondition:     N/A
+    //Post condition:   Stores value at address, allocating its page
+    void write(uint32_t address, uint32_t value) {
+        page(address)[address & (PAGE_WORDS - 1)] = value;
+    }
+
+    //Precondition:     N/A
+    //Post condition:   Returns the page holding address, allocating it and
+    //                  its page table when they are still shared
+    uint32_t *page(uint32_t address);
+
+    //Precondition:     N/A
+    //Post condition:   Stores count words starting at address
+    void load(uint32_t address, const uint32_t *words, size_t count);
+
+    //Precondition:     N/A
+    //Post condition:   Frees every page, all of memory reads as zero
+    void clear();
+
+    //Precondition:     N/A
+    //Post condition:   Returns the number of allocated pages
+    size_t pagesAllocated() const { return pages.size(); }
+
+    //Precondition:     index is less than pagesAllocated()
+    //Post condition:   Returns the page number of an allocated page
+    uint32_t allocatedPage(size_t index) const { return pageNumbers[index]; }
+
+    //Precondition:     N/A
+    //Post condition:   Returns the page holding address without allocating it
+    const uint32_t *pageAt(uint32_t address) const {
+        return directory[address >> (PAGE_BITS + TABLE_BITS)]
+                [(address >> PAGE_BITS) & (TABLE_PAGES - 1)];
+    }
+
+    //directory and zero page for code that walks the tables itself
+    uint32_t **const *root() const { return directory; }
+    const uint32_t *zero() const { return zeroPage; }
+
+private:
+
+    uint32_t **directory[DIRECTORY_TABLES];
+
+    //unwritten tables and pages point here
+    uint32_t *zeroTable[TABLE_PAGES];
+    uint32_t zeroPage[PAGE_WORDS] = {};
+
+    //allocated tables and pages, with the page number of each page
+    vector<unique_ptr<uint32_t *[]>> tables;
+    vector<unique_ptr<uint32_t []>> pages;
+    vector<uint32_t> pageNumbers;
+
+};
+
+#ifdef NATIVE_TRANSLATION
+
+//State used by translated code, every register is at a fixed offset
+struct NATIVE_CONTEXT{
+
+    int32_t registers[32];
+    long long executed;
+
+    //data memory, the translated code walks its page tables and calls
+    //nativeTouchPage before storing to a zero page
+    uint32_t **const *directory;
+    const uint32_t *zeroPage;
+    PagedMemory *memory;
+
+};
 
 //Precondition:     N/A
-//Post condition:   Creates file with instructions and clock cycle at each stage
-void writeOutput(string filename);
+//Post condition:   Returns the page of address, called by translated code
+uint32_t *nativeTouchPage(PagedMemory *memory, uint32_t address);
 
-//Precondition:     Instruction vectors are initalized
-//Post condition:   Instruction vectors are populated with opcodes and funct for
-//                  the instructions
-void loadInstrucionList();
+//Translated code takes the context and returns the index of the
+//instruction it stopped at
+typedef int (*nativeEntry)(NATIVE_CONTEXT *context);
 
-//Precondition:     Register list is initalized
-//Post condition:   Popluates registers 
-void loadRegister();
+//x86-64 code translated from threaded code one basic block at a time, blocks
+//jump straight to the blocks they branch to
+class NativeCode{
 
-//Precondition:     Register list is initalized and popluated from instruction
-//Post condition:   Creates a txt with register values
-void writeRegisterValue();
+public:
 
-//Precondition:     Data list is initalized and updated from instruction
-//Post condition:   Creates a txt with updated data
-void writeDataValue();
+    NativeCode() = default;
+    NativeCode(const NativeCode &) = delete;
+    NativeCode &operator=(const NativeCode &) = delete;
+    ~NativeCode();
 
-//-----------------------------------------------------------------------------
+    //Precondition:     Threaded code ends with a halt
+    //Post condition:   Translates the threaded code into executable memory,
+    //                  returns false when nothing could be translated
+    bool translate(const vector<THREADED_INST> &threadedCode);
 
-//Precondition:     LIST_REG_INDEX is poplutated   
-//Post condition:   Returns the index of a given register as it correlates with
-//                  the register's index in the register array
-int getRegIndex(string reg);
+    //Precondition:     Code was translated
+    //Post condition:   Runs from the first instruction and returns the index
+    //                  of the instruction it stopped at
+    int run(NATIVE_CONTEXT &context) const;
 
-//Precondition:     N/A    
-//Post condition:   Returns binary number with the given number of bits
-string decimalToBinaryStr (int number, int numBits); 
+    //Precondition:     N/A
+    //Post condition:   Returns if there is translated code to run
+    bool translated() const { return code != nullptr; }
 
-//-----------------------------------------------------------------------------
+private:
 
-//Precondition:     N/A    
-//Post condition:   Instructions are ran in pipline order
-void runInstructions();
+    //Precondition:     N/A
+    //Post condition:   Unmaps the translated code
+    void release();
 
-//Precondition:     Instrution memory is populated    
-//Post condition:   Fetches instructions and populates registers
-void instructionFetch();
+    //Precondition:     N/A
+    //Post condition:   Appends bytes to the code being assembled
+    void emit(initializer_list<uint8_t> bytes);
+    void emitInt(int32_t value);
 
-//Precondition:     Instruction was fetched   
-//Post condition:   Decodes instructions and populates registers
-void instructionDecode();
+    //Precondition:     N/A
+    //Post condition:   Appends an instruction with operand [rdi + offset] where
+    //                  reg is the other operand
+    void emitContext(initializer_list<uint8_t> opcode, int reg, int offset);
 
-//Precondition:     Instruction was decoded   
-//Post condition:   Executes instructions and populates registers
-void execute_iu1();
+    //code is assembled here before being copied to executable memory
+    vector<uint8_t> buffer;
 
-//Precondition:     Instruction was decoded   
-//Post condition:   Executes instructions and populates registers
-void execute_iu2();
+    void *code = nullptr;
+    size_t codeSize = 0;
 
-//Precondition:     Instruction was decoded   
-//Post condition:   Executes instructions and populates registers
-void execute_iu3();
+};
 
-//Precondition:     Instrucion was executed    
-//Post condition:   Access memory for intruction and populates registers
-void accessMemory();
+#endif
 
-//Precondition:     Instrucion memory accessed    
-//Post condition:   Writes to register in instructions and populates registers
-void writeBack();
+//Precondition:     N/A
+//Post condition:   Returns the fields and controls of an instruction word
+DECODED_INST predecode(uint32_t instruction);
 
-//-----------------------------------------------------------------------------
+//Mnemonics with their row of INSTRUCTION_TABLE
+typedef unordered_map<string, const INSTRUCTION_INFO *> mnemonicIndex;
 
-//Precondition:     N/A    
-//Post condition:   Poplates id_ex registers with proper alu controls
-void makeControl(string opcode, string funct);
+//Precondition:     N/A
+//Post condition:   Returns every mnemonic of INSTRUCTION_TABLE with its row
+mnemonicIndex loadMnemonicIndex();
 
-//Precondition:     N/A    
-//Post condition:   Returns operations with given variables
-string ALU(string var1, string var2, string control);
+//index indicating index of register
+const int INDEX_V = 2, INDEX_A = 4, INDEX_T0 = 8, INDEX_S = 16
+                    , INDEX_T8 = 24, INDEX_K = 26;
 
-//Precondition:     N/A    
-//Post condition:   Returns alu control given op code and funct
-string ALUcontrol(string aluOp, string funct, string opcode);
+//Precondition:     N/A
+//Post condition:   Returns the table of every register name, $0-$31 and the
+//                  named registers other than $zero
+constexpr registerTable loadRegisterTable(){
 
-//Precondition:     N/A    
-//Post condition:   Popluates instruction queue with respect to current clock cycle
-void insertQueue();
+    registerTable table = {};
 
-//-----------------------------------------------------------------------------
+    for (int8_t &index : table)
+        index = -1;
 
-//Precondition:     N/A    
-//Post condition:   Detects hazards and forwards when possible
-void forwarding();
+    //numbered registers
+    for (int i = 0; i < 32; i++) {
 
-//Precondition:     N/A    
-//Post condition:   Detects load-use hazards then stalls accordingly
-void hazardDetection();
+        if (i < 10)
+            table[('0' + i) * 128] = i;
+        else
+            table[('0' + i / 10) * 128 + '0' + i % 10] = i;
 
+    }
 
-//IF_ID Register
-struct IF_ID{
+    //named registers, a letter followed by a number counting from the first
+    //register of the group
+    for (int i = 0; i < 2; i++) {
 
-    string fetchedInstruction;
-    bool stopInstrucions = false;
+        table['v' * 128 + '0' + i] = INDEX_V + i;
+        table['k' * 128 + '0' + i] = INDEX_K + i;
+        table['t' * 128 + '8' + i] = INDEX_T8 + i;
 
-    int nextAddress;
-    bool writeFlushed = 0;
+    }
 
-} if_idReg;
+    for (int i = 0; i < 4; i++)
+        table['a' * 128 + '0' + i] = INDEX_A + i;
 
-//ID_IU1 Register
-struct ID_IU1{
+    for (int i = 0; i < 8; i++) {
 
-    string readData1, readData2;
-    string instrutction15_0;
-    string instrutction20_16;
-    string instrutction15_11;
-    string opcode;
+        table['t' * 128 + '0' + i] = INDEX_T0 + i;
+        table['s' * 128 + '0' + i] = INDEX_S + i;
 
-    int nextAddress;
-    int jumpAddress;
+    }
 
-    //Controls
-    bool aluSrc;
-    string aluOp;
-    bool regDst;
+    table['a' * 128 + 't'] = 1;
+    table['g' * 128 + 'p'] = 28;
+    table['s' * 128 + 'p'] = 29;
+    table['f' * 128 + 'p'] = 30;
+    table['s' * 128 + '8'] = 30;
+    table['r' * 128 + 'a'] = 31;
 
-    bool memWrite;
-    bool memRead;
+    return table;
+}
 
-    bool regWrite;
-    bool memToReg;
+//Table of register names, built when compiling
+constexpr registerTable REGISTER_TABLE = loadRegisterTable();
 
-    bool branchBEQ = 0;
-    bool branchBNE = 0;
-    bool jump = 0;
+//Precondition:     N/A
+//Post condition:   Returns the index of a given register as it correlates with
+//                  the register's index in the register array, throws for
+//                  names that are not a register
+int getRegIndex(const string &reg);
 
-    //controls for forwarding
-    string registerRs;
-    string registerRt;
-    string registerRd;
+//Number of characters in a formatted word
+const int BINARY_WORD = 32;
 
-    //tracks nops
-    bool idNOP = 0, exNOP = 0, memNOP = 0, wbNOP = 0;
+//Characters of the eight bits of every byte value
+typedef array<array<char, 8>, 256> binaryTable;
 
-    //tracks branching and jumping
-    bool branch_jump = 0;
+//Precondition:     N/A
+//Post condition:   Returns the characters of every byte value, highest bit
+//                  first
+constexpr binaryTable loadBinaryTable(){
 
-    //tracks flushing
-    bool writeFlushed = 0;
+    binaryTable table = {};
 
-    //indicates IU execution
-    string execute_inst;
-    bool executed = 0;
+    for (int value = 0; value < 256; value++) {
 
-} id_iu1Reg;
+        for (int bit = 0; bit < 8; bit++)
+            table[value][bit] = ((value >> (7 - bit)) & 1) ? '1' : '0';
 
-//IU1_IU2 Register
-struct IU1_IU2{
+    }
 
-    //stores IU1 result values
-    string aluResult;
-    string regDestination;
+    return table;
+}
 
-    string readData1, readData2;
-    string instrutction15_0;
-    string instrutction20_16;
-    string instrutction15_11;
-    string opcode;
+//Table of formatted bytes, built when compiling
+constexpr binaryTable BINARY_TABLE = loadBinaryTable();
 
-    int nextAddress;
-    int jumpAddress;
+//Precondition:     buffer holds at least BINARY_WORD characters
+//Post condition:   Writes the bits of value highest first into buffer, returns
+//                  the position after the last character
+char *formatBinary(char *buffer, uint32_t value);
 
-    //Controls
-    bool aluSrc;
-    string aluOp;
-    bool regDst;
+//Precondition:     N/A
+//Post condition:   Returns binary number with the given number of bits, built
+//                  one character at a time the way the datapath formatted
+//                  values before they were carried as integers, only kept as
+//                  the baseline of the benchmark mode
+string insertBinaryStr(int number, int numBits);
+
+//Checkpoint files start with the magic, the format version and the size of
+//each pipline register, every checkpoint is appended as its length, its
+//contents and its length again so one cut off by a crash is skipped
+const char CHECKPOINT_MAGIC[8] = {'M', 'I', 'P', 'S', 'C', 'K', 'P', 'T'};
+const uint32_t CHECKPOINT_VERSION = 3;
 
-    bool memWrite;
-    bool memRead;
+//Precondition:     N/A
+//Post condition:   Appends the bytes of value to record
+template <class T>
+void putBytes(string &record, const T &value);
 
-    bool regWrite;
-    bool memToReg;
+//Precondition:     N/A
+//Post condition:   Copies the bytes at pos into value and moves pos past them,
+//                  throws when end comes first
+template <class T>
+void getBytes(const char *&pos, const char *end, T &value);
 
-    //might remove
-    bool branchBEQ = 0;
-    bool branchBNE = 0;
-    bool jump = 0;
+//Binary trace files start with the magic, the format version and the
+//program, each instruction word with its source row, followed by one record
+//for every header or row of the text output
+const char TRACE_MAGIC[8] = {'M', 'I', 'P', 'S', 'T', 'R', 'C', 'E'};
+const uint32_t TRACE_VERSION = 1;
 
-    //controls for forwarding
-    string registerRs;
-    string registerRt;
-    string registerRd;
+//Columns of a row, IF ID EX MEM WB
+const int TRACE_COLUMNS = 5;
+enum TRACE_COLUMN { COLUMN_IF, COLUMN_ID, COLUMN_EX, COLUMN_MEM, COLUMN_WB };
 
-    //tracks nops
-    bool exNOP = 0, memNOP = 0, wbNOP = 0;
+//Clock cycle each stage tracked for one row of the output, a row is one
+//fetched instruction
+struct TRACE_ROW{
 
-    //tracks branching and jumping
-    bool branch_jump = 0;
+    //instruction the row was fetched from
+    int pc = 0;
 
-    //tracks flushing
-    bool writeFlushed = 0;
+    //0 for a squashed stage
+    int clocks[TRACE_COLUMNS] = {};
 
-    //indicates IU execution
-    string execute_inst;
-    bool executed = 0;
+    //stages that have tracked the row, one bit per column
+    uint8_t columns = 0;
 
-} iu1_iu2Reg;
+};
 
+//First byte of a record, the low bits tell which columns the row has, a
+//header record is only this byte
+//  TRACE_HEADER    record is the header line
+//  TRACE_FLUSHED   a stage after IF was squashed
+//  TRACE_STALLED   ID came more than a cycle after IF
+const uint8_t TRACE_HEADER = 0x20, TRACE_FLUSHED = 0x40, TRACE_STALLED = 0x80;
 
-//IU2_IU3 Register
-struct IU2_IU3{
+//Precondition:     pos has room for 10 bytes
+//Post condition:   Writes value 7 bits a byte, lowest first, returns the
+//                  position after it
+char *putVarint(char *pos, uint64_t value);
 
-    //stores IU2 result values
-    string aluResult;
-    string regDestination;
+//Precondition:     N/A
+//Post condition:   Returns the value written by putVarint at pos and moves pos
+//                  past it, throws when end comes first
+uint64_t getVarint(const char *&pos, const char *end);
 
-    string readData1, readData2;
-    string instrutction15_0;
-    string instrutction20_16;
-    string instrutction15_11;
-    string opcode;
+//Precondition:     N/A
+//Post condition:   Writes the header line of the text output
+void writeTableHeader(ostream &out);
 
-    int nextAddress;
-    int jumpAddress;
+//Precondition:     clocks holds the cycle of every column columns has, 0 for
+//                  a squashed stage
+//Post condition:   Writes a row of the text output
+void writeTableRow(ostream &out, const string &sourceRow, const int *clocks
+                    , uint8_t columns);
 
-    //Controls
-    bool aluSrc;
-    string aluOp;
-    bool regDst;
+//Precondition:     N/A
+//Post condition:   Writes the text output a binary trace file holds
+void renderTrace(string traceFile, string outputFile);
+
+//Precondition:     N/A    
+//Post condition:   Returns operations with given variables
+int32_t ALU(int32_t var1, int32_t var2, ALU_OP control);
+
+//Number of data contexts the lockstep mode runs at once
+const int LOCKSTEP_LANES = 64;
+
+//One word per lockstep lane
+typedef array<int32_t, LOCKSTEP_LANES> LANE_WORDS;
+
+//Precondition:     mask is -1 for lanes that run the operation and 0 otherwise
+//Post condition:   Stores operations with given variables in dest for the
+//                  masked lanes
+LANE_KERNEL
+void laneALU(LANE_WORDS &dest, const LANE_WORDS &var1, const LANE_WORDS &var2
+                , const LANE_WORDS &mask, ALU_OP control);
+
+//Precondition:     mask is -1 for lanes that take the new value and 0 otherwise
+//Post condition:   Stores value in dest for the masked lanes
+LANE_KERNEL
+void laneSelect(LANE_WORDS &dest, const LANE_WORDS &value, const LANE_WORDS &mask);
+
+//Tables shared by every simulator, they are only read after being built
+const mnemonicIndex MNEMONIC_INDEX = loadMnemonicIndex();
+
+//predecoded nop used when flushing
+const DECODED_INST NOP_INSTRUCTION = predecode(0);
+
+//represents pipline stages with numbers, the execute stages are followed by
+//the access and write back stages
+const int FETCH = 1, DECODE = 2, EXECUTE_1 = 3;
+
+//number of execute stages unless another depth is given
+const int DEFAULT_EX_DEPTH = 3;
 
-    bool memWrite;
-    bool memRead;
+//Pipline policies, each project version is one instantiation of the pipline
+//stages and logic a policy turns off is compiled out of it
+//  HAZARDS         stalls on hazards forwarding cannot cover
+//  FORWARDING      forwards results to ID and IU1
+//  BRANCH_STAGE    stage branches and jumps are resolved in, 0 never taken
+//  EX_DEPTH        number of execute stages, 0 uses the depth given at runtime
+struct POLICY_V1{
 
-    bool regWrite;
-    bool memToReg;
+    static constexpr bool HAZARDS = 0;
+    static constexpr bool FORWARDING = 0;
+    static constexpr int BRANCH_STAGE = 0;
+    static constexpr int EX_DEPTH = 1;
 
-    //might remove
-    bool branchBEQ = 0;
-    bool branchBNE = 0;
-    bool jump = 0;
+};
+
+struct POLICY_V2{
+
+    static constexpr bool HAZARDS = 1;
+    static constexpr bool FORWARDING = 1;
+    static constexpr int BRANCH_STAGE = DECODE;
+    static constexpr int EX_DEPTH = 1;
+
+};
+
+struct POLICY_V3{
+
+    static constexpr bool HAZARDS = 1;
+    static constexpr bool FORWARDING = 1;
+    static constexpr int BRANCH_STAGE = DECODE;
+    static constexpr int EX_DEPTH = 0;
+
+};
+
+//pipline used unless another version is given
+const int DEFAULT_VERSION = 3;
+
+//Size pipline registers are aligned to so each starts its own cache line
+const int CACHE_LINE = 64;
+
+//IF_ID Register
+struct alignas(CACHE_LINE) IF_ID{
+
+    const DECODED_INST *fetchedInstruction = &NOP_INSTRUCTION;
+    bool stopInstrucions = false;
+
+    int32_t nextAddress = 0;
+
+};
+
+//ID_IU1 and IU_IU Registers, latch k is read by execute stage k + 1
+struct alignas(CACHE_LINE) EX_LATCH{
+
+    //stores IU result values
+    int32_t aluResult = 0;
+
+    int32_t readData1 = 0, readData2 = 0;
+    int32_t instrutction15_0 = 0;
+
+    int32_t nextAddress = 0;
+    int32_t jumpAddress = 0;
+
+    //Controls, CTRL_ bits of the instruction
+    uint16_t control = 0;
+    ALU_OP aluOp = ALU_ADD;
+
+    uint8_t regDestination = 0;
 
     //controls for forwarding
-    string registerRs;
-    string registerRt;
-    string registerRd;
+    uint8_t registerRs = 0;
+    uint8_t registerRt = 0;
 
     //tracks nops
-    bool exNOP = 0, memNOP = 0, wbNOP = 0;
+    bool idNOP = 0, exNOP = 0, memNOP = 0, wbNOP = 0;
 
     //tracks branching and jumping
     bool branch_jump = 0;
@@ -345,24 +686,21 @@ struct IU2_IU3{
     bool writeFlushed = 0;
 
     //indicates IU execution
-    string execute_inst;
+    uint8_t execute_inst = 0;
     bool executed = 0;
 
-} iu2_iu3Reg;
+};
 
-//EXE_MEM Register
-struct IU3_MEM{
+//EX_MEM Register
+struct alignas(CACHE_LINE) EX_MEM{
 
-    string aluResult;
-    string readData2;
-    string regDestination;
+    int32_t aluResult = 0;
+    int32_t readData2 = 0;
 
-    //Controls
-    bool memWrite;
-    bool memRead;
+    //Controls, CTRL_ bits of the instruction
+    uint16_t control = 0;
 
-    bool regWrite;
-    bool memToReg;
+    uint8_t regDestination = 0;
     
     //tracks nops
     bool memNOP = 0, wbNOP = 0;
@@ -373,22 +711,18 @@ struct IU3_MEM{
     //tracks flushing
     bool writeFlushed = 0;
 
-    bool executed = 0;
-
-} iu3_memReg;
+};
 
 //MEM_WB Registers
-struct MEM_WB{
+struct alignas(CACHE_LINE) MEM_WB{
 
-    string readDataMem;
-    string aluResult;
-    string regDestination;
-
-    string muxALU;
+    int32_t readDataMem = 0;
+    int32_t aluResult = 0;
     
-    //Controls
-    bool regWrite;
-    bool memToReg;
+    //Controls, CTRL_ bits of the instruction
+    uint16_t control = 0;
+
+    uint8_t regDestination = 0;
 
     //tracks nops
     bool wbNOP = 0;
@@ -399,32 +733,68 @@ struct MEM_WB{
     //tracks flushing
     bool writeFlushed = 0;
     
-} mem_wbReg;
+};
+
+//pipline registers are copied every cycle, each must stay a plain copy of one
+//cache line
+static_assert(is_trivially_copyable<IF_ID>::value && sizeof(IF_ID) == CACHE_LINE
+                , "IF_ID must fit a cache line");
+static_assert(is_trivially_copyable<EX_LATCH>::value && sizeof(EX_LATCH) == CACHE_LINE
+                , "EX_LATCH must fit a cache line");
+static_assert(is_trivially_copyable<EX_MEM>::value && sizeof(EX_MEM) == CACHE_LINE
+                , "EX_MEM must fit a cache line");
+static_assert(is_trivially_copyable<MEM_WB>::value && sizeof(MEM_WB) == CACHE_LINE
+                , "MEM_WB must fit a cache line");
+
+//Precondition:     N/A
+//Post condition:   Returns the value write back writes to the register file
+inline int32_t writeBackValue(const MEM_WB &reg){
+
+    //checks to write register from memory
+    if (reg.control & CTRL_MEM_TO_REG)
+        return reg.readDataMem;
+
+    return reg.aluResult;
+}
+
+//Latch a forwarded value is taken from
+enum FORWARD_SOURCE { FORWARD_NONE, FORWARD_MEM_WB, FORWARD_EX_MEM
+                    , FORWARD_EX_LATCH };
+
+//Forwarding select, latch is the EX latch when forwarding from one
+struct FORWARD_SELECT{
+
+    FORWARD_SOURCE source = FORWARD_NONE;
+    int latch = 0;
+
+};
+
+//Precondition:     N/A
+//Post condition:   Returns the scoreboard bit of a register written by a latch,
+//                  no bit when the latch does not write or writes $zero
+inline uint32_t registerBit(bool regWrite, int reg){
+
+    if (!regWrite || reg == 0)
+        return 0;
+
+    return uint32_t(1) << reg;
+}
 
 //forwarding unit
 struct FORWARD_UNIT{
 
-    //units for forwarding
-    bool mem_wbRegWrite = 0;
-    bool iu3_memRegWrite = 0;
-    bool iu2_iu3RegWrite = 0;
-    bool iu1_iu2RegWrite = 0;
-
-    string mem_wbRegisterRd = "";
-    string iu3_memRegisterRd = "";
-    string iu2_iu3RegisterRd = "";
-    string iu1_iu2RegisterRd = "";
-    
-    string registerRs = "";
-    string registerRt = "";
+    //registers written by each latch, one bit per register, exWrites is
+    //indexed by EX latch
+    uint32_t mem_wbWrites = 0;
+    uint32_t ex_memWrites = 0;
+    vector<uint32_t> exWrites;
 
-    string forwardA = "";
-    string forwardB = "";
-    
-    //tracks where to forward
-    bool forwardID = 0;
+    //registers whose result the latch already holds, a load's is only in
+    //MEM_WB
+    uint32_t ex_memReady = 0;
+    vector<uint32_t> exReady;
 
-} fw_unit;
+};
 
 
 struct HAZARD_UNIT{
@@ -432,1030 +802,3921 @@ struct HAZARD_UNIT{
     //units for hazard detection
     bool stall = 0;
     bool PCWrite = 1;
-    bool id_iu1MemRead = 0;
-    bool iu1_iu2MemRead = 0;
-    bool iu2_iu3MemRead = 0;
 
-    string id_iu1RegisterRt = "";
-    string iu1_iu2RegisterRt = "";
-    string iu2_iu3RegisterRt = "";
-    
-    string if_idRegisterRs = "";
-    string if_idRegisterRt = "";
+    //registers whose newest value in flight no latch forwarding reads holds
+    //yet, in this clock cycle and in the next one
+    uint32_t pendingNow = 0;
+    uint32_t pendingNext = 0;
 
-    string iu1_iu2RegisterRd = "";
-    string iu2_iu3RegisterRd = "";
+};
 
-    string exe_instruction = "";
-    string iu1_iu2_instruction = "";
-    string iu2_iu3_instruction = "";
+//Read only view of a whole file, mapped into memory where the system allows
+//it and read into a buffer otherwise
+class MappedFile{
 
-    bool iu1_iu2RegWrite;
-    bool iu2_iu3RegWrite; 
-    
-    bool iu1executed = 0;
-    bool iu2executed = 0;
-    bool iu3executed = 0;
+public:
+
+    //Precondition:     N/A
+    //Post condition:   Maps the file, fail() is set when it cannot be opened
+    explicit MappedFile(const string &filename);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    bool fail() const { return failed; }
+    const char *begin() const { return data; }
+    const char *end() const { return data + size; }
+
+private:
+
+    const char *data = nullptr;
+    size_t size = 0;
+    bool failed = 0;
+    bool mapped = 0;
+
+    //contents when the file is not mapped
+    string buffer;
+
+};
+
+//Data memory as loaded, words parsed from a text file or a mapped binary image
+struct DATA_IMAGE{
+
+    const uint32_t *words = nullptr;
+    size_t size = 0;
+
+};
+
+//Position of the assembler in the source text
+struct SOURCE_CURSOR{
+
+    const char *pos;
+    const char *end;
+
+};
+
+//Forward reference to a label, patched in once every label is known
+struct BACKPATCH{
+
+    int index;
+    string label;
+    uint32_t fieldMask;
+
+};
 
-} hazard_unit;
+//Precondition:     N/A
+//Post condition:   Returns the next whitespace separated token, empty at the
+//                  end of the source
+string nextToken(SOURCE_CURSOR &cursor);
+
+//Precondition:     N/A
+//Post condition:   Returns the text up to the next comma with whitespace
+//                  removed, the comma is skipped
+string nextField(SOURCE_CURSOR &cursor);
+
+//Precondition:     N/A
+//Post condition:   Returns a cursor over the rest of the current line and
+//                  moves the cursor past it
+SOURCE_CURSOR restOfLine(SOURCE_CURSOR &cursor);
+
+//Precondition:     N/A
+//Post condition:   Appends text to a source row, padded with spaces to width
+void appendPadded(string &row, const string &text, size_t width);
+
+//Precondition:     N/A
+//Post condition:   Returns the 16 bit field of a decimal constant or of a
+//                  hex constant ending in h, throws if the whole constant is
+//                  not a number or it does not fit 16 bits
+uint32_t parseConstant(const string &constant);
+
+//Data context of a lockstep run - data file - prefix of its output files
+struct LOCKSTEP_JOB{
+
+    string data;
+    string outputPrefix;
+
+};
+
+//Registers, data memory and PC of the lockstep lanes, word w of the data
+//file of lane l is data[w][l] so one instruction reads and writes every lane
+//with a vector
+struct LANE_CONTEXTS{
+
+    LANE_WORDS registers[32];
+    vector<LANE_WORDS> data;
+    LANE_WORDS pc;
+
+    //words outside the data file by address, like PagedMemory a word reads
+    //as zero until it is written
+    unordered_map<uint32_t, LANE_WORDS> otherWords;
+
+};
+
+//CPI measured by sampled simulation
+struct SAMPLE_STATS{
+
+    //instructions executed and complete sampling windows
+    long long instructions = 0;
+    long long samples = 0;
+
+    //mean CPI of the windows and half the width of its 95% confidence
+    //interval, -1 with fewer than two windows
+    double cpi = 0;
+    double cpiError = -1;
+
+};
+
+//z value of a 95% confidence interval
+const double CONFIDENCE_Z = 1.96;
+
+//most sampling windows running in children at once, well below the results
+//a pipe holds
+const int MAX_FORKS = 256;
+
+#ifdef FORKED_SAMPLES
+//Result a forked sampling window sends back, small enough for one atomic
+//pipe write
+struct WINDOW_RESULT{
+
+    int64_t sample;
+    int64_t cycles;
+
+};
+
+//Precondition:     Read end of the pipe does not block
+//Post condition:   Stores every result waiting in the pipe into windowCycles
+void readWindowResults(int results, vector<long long> &windowCycles);
+
+//Precondition:     A sampling child is running, read end of the pipe does
+//                  not block
+//Post condition:   Waits for a child to exit, reading the pipe while waiting
+//                  so no child blocks writing its result
+void reapWindow(int results, vector<long long> &windowCycles);
+#endif
+
+//instructions a sampling window runs in the pipline before measuring
+const long long DEFAULT_SAMPLE_WARMUP = 50;
+
+//Simulates the pipline for one program, every run of the program starts from
+//the loaded instruction and data memory so a simulator can be run many times
+//and several simulators can run side by side
+class Simulator{
+
+public:
+
+    //Precondition:     N/A
+    //Post condition:   Creates a simulator with the pipline of the given
+    //                  version, exDepth is only used by versions without a
+    //                  fixed number of execute stages
+    explicit Simulator(int exDepth = DEFAULT_EX_DEPTH
+                        , int version = DEFAULT_VERSION);
+
+    //Precondition:     N/A
+    //Post condition:   Parses instruction file inserting into instruction memory
+    //                  and formats its source rows for the output file
+    void loadProgram(string filename);
+
+    //Precondition:     N/A
+    //Post condition:   Stores data file into data memory, a file ending in
+    //                  .bin is mapped as a raw image of words, any other file
+    //                  is read as one 32 bit binary word of text per line
+    void loadData(string filename);
+
+    //Precondition:     Program and data are loaded
+    //Post condition:   Restores registers, data memory and the pipline to the
+    //                  state before the first clock cycle
+    void reset();
+
+    //Precondition:     Program and data are loaded
+    //Post condition:   Resets then runs the program, writing each instruction's
+    //                  stage clocks to the output file
+    void run(string outputFile);
+
+    //Precondition:     N/A
+    //Post condition:   Pipline runs write a binary trace to the output file
+    //                  instead of the text table when binary is set
+    void setBinaryTrace(bool binary) { binaryTrace = binary; }
+
+    //Precondition:     N/A
+    //Post condition:   Pipline runs call the stages of each clock cycle in an
+    //                  order shuffled by seed, 0 keeps the usual order
+    void setStageShuffle(unsigned seed) { stageShuffle = seed; }
+
+    //Precondition:     N/A
+    //Post condition:   Pipline runs write a checkpoint to filename every
+    //                  interval clock cycles, the first holds every page of
+    //                  memory and the later ones only the pages written since
+    void setCheckpoint(string filename, long long interval);
+
+    //Precondition:     Program and data are loaded, the checkpoint was taken
+    //                  with the same program, execute depth and version
+    //Post condition:   Restores the last complete checkpoint of the file then
+    //                  runs the rest of the program, the output file is cut
+    //                  back to where the checkpoint left it and appended to
+    void resume(string checkpointFile, string outputFile);
+
+    //Precondition:     Program and data are loaded
+    //Post condition:   Resets then executes the program one instruction at a
+    //                  time without pipline timing, returns the number of
+    //                  instructions executed
+    long long runFunctional();
+
+    //Precondition:     Program and data are loaded, version takes branches
+    //Post condition:   Resets then executes the program functionally, every
+    //                  period instructions the pipline runs a window of
+    //                  warmup + window instructions from the current state
+    //                  and the cycles of the last window instructions are
+    //                  measured, returns the CPI of the samples, windows run
+    //                  in up to forks children at once where fork exists,
+    //                  forks is ignored elsewhere
+    SAMPLE_STATS runSampled(long long period, long long window, long long warmup
+                            , int forks = 1);
+
+    //Precondition:     Program is loaded
+    //Post condition:   Executes the program functionally on every data context
+    //                  in lockstep, writing <prefix>register.txt and
+    //                  <prefix>dataUpdate.txt of each, returns the number of
+    //                  instructions executed over every context
+    long long runLockstep(const vector<LOCKSTEP_JOB> &jobs);
+
+    //Precondition:     Register list is initalized and popluated from instruction
+    //Post condition:   Creates a txt with register values
+    void writeRegisterValue(string filename) const;
+
+    //Precondition:     Data list is initalized and updated from instruction
+    //Post condition:   Creates a txt with updated data
+    void writeDataValue(string filename) const;
+
+    //Precondition:     N/A
+    //Post condition:   Returns the text of the register file
+    string formatRegisters() const;
+
+    //Precondition:     N/A
+    //Post condition:   Returns the text of data memory
+    string formatData() const;
+
+private:
+
+    //Precondition:     N/A
+    //Post condition:   Parses instruction file inserting into instruction
+    //                  memory and the formatted source text of each
+    //                  instruction into sourceRows
+    void loadInstruction(string filename);
+
+    //Precondition:     Instruction memory is populated
+    //Post condition:   Decodes every instruction word once into
+    //                  decodedInstructions followed by a halt for fetches
+    //                  past the last instruction
+    void predecodeInstructions();
+
+    //Precondition:     Instructions are predecoded
+    //Post condition:   Translates the predecoded instructions into threadedCode
+    //                  for the functional mode
+    void translateThreaded();
+
+    //Precondition:     Lanes hold the starting state of their contexts, lanes
+    //                  without a context have the halted PC
+    //Post condition:   Runs the threaded code on every lane until all halt,
+    //                  returns the number of instructions executed
+    long long runLanes(LANE_CONTEXTS &lanes) const;
+
+    //Precondition:     Source rows are loaded
+    //Post condition:   Appends the rows of the instructions still in the
+    //                  pipline to the output file
+    void writeOutput();
+
+    //Precondition:     N/A
+    //Post condition:   Starts the row of an instruction fetched from pc
+    void trackFetch(int pc);
+
+    //Precondition:     The stage's next row was fetched
+    //Post condition:   Sets the clock cycle of a stage in the next row it
+    //                  tracks, a row is written once write back tracks it
+    void trackClock(int column, int clock);
+
+    //Precondition:     Output file is open
+    //Post condition:   Runs the pipline until it halts and writes the rest of
+    //                  the output file
+    void finishRun();
+
+    //Precondition:     N/A
+    //Post condition:   Empties the pipline, registers, memory and PC are kept
+    void resetPipeline();
+
+    //Precondition:     Output file is open for a binary trace
+    //Post condition:   Writes the magic, version and program of the trace
+    void writeTraceProgram();
+
+    //Precondition:     Threaded code is translated
+    //Post condition:   Executes instructions functionally from PC until it
+    //                  halts, or until count have executed when COUNTED, and
+    //                  leaves PC at the next one, returns the number executed
+    template <bool COUNTED>
+    long long runThreaded(long long count);
+
+    //Precondition:     N/A
+    //Post condition:   Runs the pipline from the current state until warmup +
+    //                  window instructions issue and returns the clock cycles
+    //                  of the last window, or -1 when it halts first, state is
+    //                  restored afterwards
+    long long sampleWindow(long long window, long long warmup);
+
+    //Precondition:     Clock cycle has been committed
+    //Post condition:   Appends a checkpoint of the pipline to the checkpoint
+    //                  file
+    void writeCheckpoint();
+
+    //Precondition:     Simulator is reset
+    //Post condition:   Replays every complete checkpoint of the file, returns
+    //                  the size the output file had at the last one
+    uint64_t restoreCheckpoint(string filename);
+
+    //Precondition:     Earlier checkpoints of the file have been read
+    //Post condition:   Restores the state of one checkpoint, returns the size
+    //                  the output file had
+    uint64_t readCheckpoint(const char *pos, const char *end);
+
+    //Precondition:     Program is loaded
+    //Post condition:   Returns a hash of instruction memory
+    uint64_t programHash() const;
+
+    //Precondition:     Output file is open
+    //Post condition:   Appends the header line to the output file
+    void writeHeader();
+
+    //Precondition:     Output file is open
+    //Post condition:   Appends a row to the output file, rows past the last
+    //                  instruction are left out
+    void writeRow(const TRACE_ROW &row);
+
+    //Precondition:     Output file is open for a binary trace
+    //Post condition:   Appends the record of one row to the trace
+    void writeTraceRecord(const TRACE_ROW &row);
+
+    //-------------------------------------------------------------------------
+
+    //Precondition:     N/A    
+    //Post condition:   Instructions are ran in pipline order with the
+    //                  pipline of the simulator's version
+    void runInstructions();
+
+    //Precondition:     N/A    
+    //Post condition:   Instructions are ran in pipline order
+    template <class POLICY>
+    void runPipeline();
+
+    //Precondition:     Instrution memory is populated    
+    //Post condition:   Fetches instructions and populates registers
+    template <class POLICY>
+    void instructionFetch();
+
+    //Precondition:     Instruction was fetched   
+    //Post condition:   Decodes instructions and populates registers
+    template <class POLICY>
+    void instructionDecode();
+
+    //Precondition:     Instruction was decoded   
+    //Post condition:   Executes instructions in the given IU and populates
+    //                  registers
+    template <class POLICY>
+    void execute(int stage);
+
+    //Precondition:     Instrucion was executed    
+    //Post condition:   Access memory for intruction and populates registers
+    void accessMemory();
+
+    //Precondition:     Instrucion memory accessed    
+    //Post condition:   Writes to register in instructions and populates registers
+    void writeBack();
+
+    //Precondition:     N/A    
+    //Post condition:   Runs the given pipline stage
+    template <class POLICY>
+    void runStage(int stage);
+
+    //Precondition:     N/A
+    //Post condition:   Returns whether an instruction in the pipline still
+    //                  has a register or memory to write
+    bool pendingWrites() const;
+
+    //Precondition:     Every stage of the clock cycle has run
+    //Post condition:   Next copies of the pipline registers become current,
+    //                  write back's register is written and ID's branch
+    //                  decision is passed to IF
+    void commitLatches();
+
+    //Precondition:     Pipline registers hold the start of the clock cycle
+    //Post condition:   Forwarding and hazard units hold the registers written
+    //                  by each pipline register and whether it is stalling
+    template <class POLICY>
+    void updateUnits();
+
+    //Precondition:     N/A
+    //Post condition:   Returns the stage number of the access and write back
+    //                  stages
+    int accessStage() const { return EXECUTE_1 + exDepth; }
+    int writeBackStage() const { return EXECUTE_1 + exDepth + 1; }
+
+    //-------------------------------------------------------------------------
+
+    //Precondition:     Forwarding unit holds the registers written by each
+    //                  latch, EX latches before firstLatch are not older than
+    //                  the reader
+    //Post condition:   Returns the latch a register is forwarded from
+    FORWARD_SELECT forwardSelect(int reg, int firstLatch) const;
+
+    //Precondition:     N/A
+    //Post condition:   Returns the forwarded value the current latch holds,
+    //                  or readData when nothing is forwarded
+    int32_t forwardValue(FORWARD_SELECT select, int32_t readData) const;
+
+    //Precondition:     Units hold the registers written by each latch
+    //Post condition:   Stalls when an operand of the decoded instruction is
+    //                  not in a latch forwarding reads by the time it is used
+    template <class POLICY>
+    void hazardDetection();
+
+    //Precondition:     N/A
+    //Post condition:   Returns a register as ID reads it, with the value
+    //                  write back is writing this clock cycle
+    int32_t readRegister(int reg) const;
+
+    //-------------------------------------------------------------------------
+
+    //number of execute stages
+    int exDepth;
+
+    //project version whose pipline is simulated
+    int version;
+
+    //labels of the loaded program with their instruction index
+    labelIndex INST_LABEL_INDEX;
+
+    //Vector to store data memory and instruction memory
+    vector<uint32_t> list_0x00;
+
+    //data memory, the loaded data starts at DATA_BASE
+    PagedMemory memory;
+
+    //data memory as loaded, restored on reset
+    DATA_IMAGE initialData;
+
+    //words of a text data file
+    vector<uint32_t> parsedData;
+
+    //mapping of a binary data image
+    unique_ptr<MappedFile> mappedData;
+
+    //predecoded instruction memory, parallel to list_0x00
+    vector<DECODED_INST> decodedInstructions;
+
+    //threaded code of the functional mode, ends with a halt
+    vector<THREADED_INST> threadedCode;
+
+    //handler addresses are filled in on the first functional run
+    bool threadedResolved = 0;
+
+#ifdef NATIVE_TRANSLATION
+    //native code of the functional mode, translated on the first functional
+    //run
+    NativeCode nativeCode;
+    bool nativeTranslated = 0;
+#endif
+
+    //formatted source text of each instruction for the output file
+    vector<string> sourceRows;
+
+    //rows fetched but not written yet, oldest first
+    deque<TRACE_ROW> pendingRows;
+
+    //rows each stage has tracked and rows written since the pipline was
+    //reset
+    long long rowsTracked[TRACE_COLUMNS] = {};
+    long long rowsWritten = 0;
+
+    //registers stored in array
+    int32_t registers[32] = {};
+
+    int PC = 0;
+    bool pcSrc = 0;
+    bool ifFlush = 0;
+    int clockCycle = 1;
+
+    //register write back writes and ID's branch decision, applied when the
+    //clock cycle is committed, writeRegisterNext is 0 when nothing is written
+    int writeRegisterNext = 0;
+    int32_t writeDataNext = 0;
+    bool pcSrcNext = 0;
+    bool ifFlushNext = 0;
+
+    //seed of the stage order, 0 runs the stages in the usual order
+    unsigned stageShuffle = 0;
+
+    ofstream outInst;
+
+    //output file is a binary trace instead of the text table
+    bool binaryTrace = 0;
 
+    //pipline registers, stages read the current copy and write the next
+    //copy which becomes current when the clock cycle is committed
+    IF_ID if_idReg, if_idNext;
+    vector<EX_LATCH> exLatches, exNext;
+    EX_MEM ex_memReg, ex_memNext;
+    MEM_WB mem_wbReg, mem_wbNext;
+
+    //units
+
+    FORWARD_UNIT fw_unit;
+    HAZARD_UNIT hazard_unit;
+
+    //checkpoint file and the clock cycles between checkpoints, 0 when not
+    //checkpointing
+    string checkpointFile;
+    long long checkpointInterval = 0;
+
+    //checkpoints in the checkpoint file, the first one is full
+    int checkpointRecords = 0;
+
+    //pages written since the last checkpoint
+    unordered_set<uint32_t> dirtyPages;
+
+    //instructions issued by ID since the pipline was reset
+    long long issued = 0;
+
+    //sampling stops the pipline once issueLimit instructions have issued
+    //and notes the clock cycle warmupIssued were reached in
+    long long issueLimit = 0;
+    long long warmupIssued = 0;
+    long long warmupCycle = 0;
+
+    //a sampling window does not write output, its stores are undone
+    bool sampling = 0;
+    vector<tuple<uint32_t, uint32_t>> undoStores;
+
+};
+
+//Job of a batch run, instruction file - data file - prefix of its output files
+struct BATCH_JOB{
+
+    string instructions;
+    string data;
+    string outputPrefix;
+
+    //number of execute stages and version of the job's pipeline
+    int exDepth = DEFAULT_EX_DEPTH;
+    int version = DEFAULT_VERSION;
+
+};
+
+//Jobs waiting for a worker, the owner takes jobs from the back and idle
+//workers steal from the front
+struct JOB_QUEUE{
+
+    mutex lock;
+    deque<int> jobs;
+
+};
+
+//Precondition:     N/A
+//Post condition:   Returns the jobs listed in a manifest file, one
+//                  <instructions> <data> <output prefix> per line
+vector<BATCH_JOB> loadManifest(string filename);
+
+//Precondition:     N/A
+//Post condition:   Returns the data contexts listed in a manifest file, one
+//                  <data> <output prefix> per line
+vector<LOCKSTEP_JOB> loadLockstepManifest(string filename);
+
+//Precondition:     N/A
+//Post condition:   Runs a job on its own simulator, writing <prefix>output.txt,
+//                  <prefix>register.txt and <prefix>dataUpdate.txt
+void runJob(const BATCH_JOB &job);
+
+//Precondition:     numThreads is at least 1
+//Post condition:   Runs every job on a pool of worker threads, returns the
+//                  number of jobs that failed
+int runBatch(const vector<BATCH_JOB> &jobs, int numThreads);
+
+//Precondition:     Queues hold the jobs of every worker
+//Post condition:   Runs jobs from the worker's queue, then steals from the
+//                  other queues until every queue is empty
+void batchWorker(int worker, vector<JOB_QUEUE> &queues
+                    , const vector<BATCH_JOB> &jobs, int &failed, mutex &failedLock);
+
+//Precondition:     N/A
+//Post condition:   Prints the cost per simulated instruction of running the
+//                  program and of formatting values as strings the previous
+//                  way against formatting the output with formatBinary
+void runBenchmark(string instructions, string data, int runs);
+
+//Precondition:     N/A
+//Post condition:   Returns the whole number an argument holds, throws when it
+//                  is not one or is outside low to high
+long long parseNumber(const string &argument, const char *name
+                        , long long low, long long high);
 
 int main(int argc, char *argv[]){
 
     try {
-        
-        //Number of arguments are not correct, needs four to execute program
-        if (argc != 4) {
 
-            throw "Format must be simulatorV3 <instructions> <data> <output>";
-                
-        }
+        //pipline options, simulatorV3 [-ex <depth>] [-version <1-3>]
+        //[-checkpoint <file> <cycles>] [-restore <file>] [-forks <count>]
+        //[-shuffle <seed>] [-binary] <mode arguments>
+        int exDepth = DEFAULT_EX_DEPTH;
+        int version = DEFAULT_VERSION;
+
+        string checkpointFile, restoreFile;
+        long long checkpointInterval = 0;
+
+        //sampling windows run on every core unless told otherwise
+        int forks = min(int(thread::hardware_concurrency()), MAX_FORKS);
+
+        bool binaryTrace = 0;
+
+        //stages run in the usual order unless a seed is given
+        unsigned stageShuffle = 0;
+
+        while (argc >= 3) {
+
+            string option = argv[1];
+
+            //the only option without a value
+            if (option == "-binary") {
+
+                binaryTrace = 1;
+
+                argc--;
+                argv++;
+                continue;
+
+            }
+
+            if (option == "-ex")
+                exDepth = parseNumber(argv[2], "execute depth", 1, INT32_MAX);
+            else if (option == "-version")
+                version = parseNumber(argv[2], "version", 1, 3);
+            else if (option == "-restore")
+                restoreFile = argv[2];
+            else if (option == "-forks")
+                forks = parseNumber(argv[2], "fork count", 1, MAX_FORKS);
+            else if (option == "-shuffle")
+                stageShuffle = parseNumber(argv[2], "shuffle seed", 1, UINT32_MAX);
+            else if (option == "-checkpoint" && argc >= 4) {
+
+                checkpointFile = argv[2];
+                checkpointInterval = parseNumber(argv[3], "checkpoint interval"
+                                                    , 1, INT64_MAX);
+
+                argc--;
+                argv++;
+
+            }
+            else
+                break;
+
+            //rest of the arguments are read as if the option was not given
+            argc -= 2;
+            argv += 2;
+
+        }
+
+        //functional mode, simulatorV3 -functional <instructions> <data>
+        if (argc == 4 && string(argv[1]) == "-functional") {
+
+            Simulator simulator;
+
+            simulator.loadProgram(argv[2]);
+            simulator.loadData(argv[3]);
+
+            simulator.runFunctional();
+
+            simulator.writeRegisterValue("register.txt");
+            simulator.writeDataValue("dataUpdate.txt");
+
+            return 0;
+
+        }
+
+        //lockstep mode, simulatorV3 -lockstep <instructions> <manifest>
+        if (argc == 4 && string(argv[1]) == "-lockstep") {
+
+            vector<LOCKSTEP_JOB> jobs = loadLockstepManifest(argv[3]);
+
+            Simulator simulator;
+
+            simulator.loadProgram(argv[2]);
+            simulator.runLockstep(jobs);
+
+            cout << jobs.size() << " data contexts completed" << endl;
+
+            return 0;
+
+        }
+
+        //sampling mode, simulatorV3 [options] -sample <instructions> <data>
+        //<period> <window> [warmup]
+        if (argc >= 6 && argc <= 7 && string(argv[1]) == "-sample") {
+
+            Simulator simulator(exDepth, version);
+
+            simulator.loadProgram(argv[2]);
+            simulator.loadData(argv[3]);
+
+            long long period = parseNumber(argv[4], "sampling period", 1, INT64_MAX);
+            long long window = parseNumber(argv[5], "sampling window", 1, INT64_MAX);
+            long long warmup = DEFAULT_SAMPLE_WARMUP;
+
+            if (argc == 7)
+                warmup = parseNumber(argv[6], "sampling warm up", 0, INT64_MAX);
+
+            SAMPLE_STATS stats = simulator.runSampled(period, window, warmup, forks);
+
+            if (stats.samples == 0)
+                throw "Program halted before a sampling window completed";
+
+            cout << fixed << setprecision(4)
+                 << "instructions:  " << stats.instructions << endl
+                 << "samples:       " << stats.samples << " windows of " << window
+                 << " instructions every " << period << endl
+                 << "CPI:           " << stats.cpi;
+
+            if (stats.cpiError >= 0)
+                cout << " +/- " << stats.cpiError << " (95% confidence)";
+
+            cout << endl << setprecision(0)
+                 << "clock cycles:  " << stats.cpi * stats.instructions;
+
+            if (stats.cpiError >= 0)
+                cout << " +/- " << stats.cpiError * stats.instructions;
+
+            cout << endl;
+
+            simulator.writeRegisterValue("register.txt");
+            simulator.writeDataValue("dataUpdate.txt");
+
+            return 0;
+
+        }
+
+        //trace rendering, simulatorV3 -render <trace> <output>
+        if (argc == 4 && string(argv[1]) == "-render") {
+
+            renderTrace(argv[2], argv[3]);
+
+            return 0;
+
+        }
+
+        //benchmark mode, simulatorV3 -bench <instructions> <data> [runs]
+        if (argc >= 4 && argc <= 5 && string(argv[1]) == "-bench") {
+
+            int runs = 10;
+
+            if (argc == 5)
+                runs = parseNumber(argv[4], "benchmark runs", 1, INT32_MAX);
+
+            runBenchmark(argv[2], argv[3], runs);
+
+            return 0;
+
+        }
+
+        //batch mode, simulatorV3 -batch <manifest> [threads]
+        if (argc >= 3 && argc <= 4 && string(argv[1]) == "-batch") {
+
+            vector<BATCH_JOB> jobs = loadManifest(argv[2]);
+
+            for (BATCH_JOB &job : jobs) {
+
+                job.exDepth = exDepth;
+                job.version = version;
+
+            }
+
+            //hardware_concurrency is 0 when the core count is not known
+            int numThreads = max(int(thread::hardware_concurrency()), 1);
+
+            if (argc == 4)
+                numThreads = parseNumber(argv[3], "thread count", 1, INT32_MAX);
+
+            int failed = runBatch(jobs, numThreads);
+
+            cout << jobs.size() - failed << " of " << jobs.size()
+                 << " jobs completed" << endl;
+
+            return failed != 0;
+
+        }
+        
+        //Number of arguments are not correct, needs four to execute program
+        if (argc != 4) {
+
+            throw "Format must be simulatorV3 [options] <instructions> <data> <output>"
+                  ", simulatorV3 -functional <instructions> <data>"
+                  ", simulatorV3 -lockstep <instructions> <manifest>"
+                  ", simulatorV3 -bench <instructions> <data> [runs]"
+                  ", simulatorV3 -render <trace> <output>"
+                  ", simulatorV3 [options] -sample <instructions> <data> <period>"
+                  " <window> [warmup]"
+                  " or simulatorV3 [options] -batch <manifest> [threads]"
+                  ", options are -ex <depth>, -version <1-3>"
+                  ", -checkpoint <file> <cycles>, -restore <file>"
+                  ", -forks <count> (ignored without fork), -shuffle <seed>"
+                  " and -binary";
+                
+        }
+
+        Simulator simulator(exDepth, version);
+
+        //Parsing instructions and populating data memory
+        simulator.loadProgram(argv[1]);
+        simulator.loadData(argv[2]);
+
+        if (!checkpointFile.empty())
+            simulator.setCheckpoint(checkpointFile, checkpointInterval);
+
+        simulator.setBinaryTrace(binaryTrace);
+        simulator.setStageShuffle(stageShuffle);
+
+        //Runs Pipline, from the start or from a checkpoint
+        if (!restoreFile.empty())
+            simulator.resume(restoreFile, argv[3]);
+        else
+            simulator.run(argv[3]);
+
+        //project output is written to files
+        simulator.writeRegisterValue("register.txt");
+        simulator.writeDataValue("dataUpdate.txt");
+
+    } catch (const char* error){
+
+        cout << "Error: "<< error << endl;
+        cout << "Example: inst.txt data.txt output.txt" << endl;
+
+    } catch (const exception &error){
+
+        //errors of the standard library, such as a constant of the
+        //instructions file that does not fit
+        cout << "Error: "<< error.what() << endl;
+        cout << "Example: inst.txt data.txt output.txt" << endl;
+
+    }
+
+}
+
+long long parseNumber(const string &argument, const char *name
+                        , long long low, long long high){
+
+    char *end = nullptr;
+
+    errno = 0;
+    long long value = strtoll(argument.c_str(), &end, 10);
+
+    //the whole argument has to be the number
+    if (argument.empty() || *end != '\0' || errno == ERANGE
+        || value < low || value > high) {
+
+        cerr << "Invalid " << name << " " << argument << endl;
+        throw "Option value is not a whole number in its range";
+    }
+
+    return value;
+}
+
+vector<BATCH_JOB> loadManifest(string filename){
+
+    ifstream loadJobs;
+    loadJobs.open(filename);
+
+    //file does not exist
+    if (loadJobs.fail()) {
+
+        cerr << "Invalid manifest file " << filename << endl;
+        throw "Manifest file could not be opened";
+    }
+
+    vector<BATCH_JOB> jobs;
+    BATCH_JOB job;
+
+    //while there are jobs to read
+    while (loadJobs >> job.instructions >> job.data >> job.outputPrefix) {
+
+        jobs.push_back(job);
+
+    }
+
+    loadJobs.close();
+
+    return jobs;
+}
+
+vector<LOCKSTEP_JOB> loadLockstepManifest(string filename){
+
+    ifstream loadJobs;
+    loadJobs.open(filename);
+
+    //file does not exist
+    if (loadJobs.fail()) {
+
+        cerr << "Invalid manifest file " << filename << endl;
+        throw "Manifest file could not be opened";
+    }
+
+    vector<LOCKSTEP_JOB> jobs;
+    LOCKSTEP_JOB job;
+
+    //while there are data contexts to read
+    while (loadJobs >> job.data >> job.outputPrefix) {
+
+        jobs.push_back(job);
+
+    }
+
+    loadJobs.close();
+
+    return jobs;
+}
+
+void runJob(const BATCH_JOB &job){
+
+    Simulator simulator(job.exDepth, job.version);
+
+    simulator.loadProgram(job.instructions);
+    simulator.loadData(job.data);
+
+    simulator.run(job.outputPrefix + "output.txt");
+
+    simulator.writeRegisterValue(job.outputPrefix + "register.txt");
+    simulator.writeDataValue(job.outputPrefix + "dataUpdate.txt");
+
+}
+
+int runBatch(const vector<BATCH_JOB> &jobs, int numThreads){
+
+    vector<JOB_QUEUE> queues(numThreads);
+
+    //deals jobs out to the workers
+    for (int i = 0; i < int(jobs.size()); i++) {
+
+        queues[i % numThreads].jobs.push_back(i);
+
+    }
+
+    int failed = 0;
+    mutex failedLock;
+
+    vector<thread> workers;
+
+    for (int i = 0; i < numThreads; i++) {
+
+        workers.push_back(thread(batchWorker, i, ref(queues), cref(jobs)
+                                , ref(failed), ref(failedLock)));
+
+    }
+
+    for (thread &worker : workers) {
+
+        worker.join();
+
+    }
+
+    return failed;
+}
+
+void batchWorker(int worker, vector<JOB_QUEUE> &queues
+                    , const vector<BATCH_JOB> &jobs, int &failed, mutex &failedLock){
+
+    int numQueues = queues.size();
+
+    while (true) {
+
+        int index = -1;
+
+        //takes the newest job of its own queue
+        {
+            lock_guard<mutex> guard(queues[worker].lock);
+
+            if (!queues[worker].jobs.empty()) {
+
+                index = queues[worker].jobs.back();
+                queues[worker].jobs.pop_back();
+
+            }
+        }
+
+        //steals the oldest job of another queue
+        for (int i = 1; i < numQueues && index == -1; i++) {
+
+            JOB_QUEUE &victim = queues[(worker + i) % numQueues];
+            lock_guard<mutex> guard(victim.lock);
+
+            if (!victim.jobs.empty()) {
+
+                index = victim.jobs.front();
+                victim.jobs.pop_front();
+
+            }
+        }
+
+        //no jobs are added once the batch starts, every queue is empty
+        if (index == -1)
+            return;
+
+        try {
+
+            runJob(jobs[index]);
+
+        } catch (const char* error) {
+
+            lock_guard<mutex> guard(failedLock);
+            cerr << "Error: job " << index + 1 << " (" << jobs[index].instructions
+                 << "): " << error << endl;
+            failed++;
+
+        } catch (const exception &error) {
+
+            lock_guard<mutex> guard(failedLock);
+            cerr << "Error: job " << index + 1 << " (" << jobs[index].instructions
+                 << "): " << error.what() << endl;
+            failed++;
+
+        }
+    }
+}
+
+void runBenchmark(string instructions, string data, int runs){
+
+    typedef chrono::steady_clock benchClock;
+
+    Simulator simulator;
+
+    simulator.loadProgram(instructions);
+    simulator.loadData(data);
+
+    long long executed = 0;
+
+    //simulated instructions
+    benchClock::time_point start = benchClock::now();
+
+    for (int run = 0; run < runs; run++)
+        executed += simulator.runFunctional();
+
+    double simulateTime = chrono::duration<double, nano>(benchClock::now() - start).count();
+
+    if (executed == 0) {
+
+        cout << "Program executed no instructions" << endl;
+        return;
+
+    }
+
+    //every simulated instruction used to format its two source registers in
+    //decode, its result in the ALU and again in write back
+    const int CONVERSIONS = 4;
+
+    size_t checksum = 0;
+
+    start = benchClock::now();
+
+    for (long long inst = 0; inst < executed; inst++) {
+
+        for (int conversion = 0; conversion < CONVERSIONS; conversion++)
+            checksum += insertBinaryStr(int(inst * CONVERSIONS + conversion), BINARY_WORD).size();
+
+    }
+
+    double insertTime = chrono::duration<double, nano>(benchClock::now() - start).count();
+
+    char buffer[BINARY_WORD];
+
+    start = benchClock::now();
+
+    for (long long inst = 0; inst < executed; inst++) {
+
+        for (int conversion = 0; conversion < CONVERSIONS; conversion++)
+            checksum += formatBinary(buffer, uint32_t(inst * CONVERSIONS + conversion)) - buffer;
+
+    }
+
+    double tableTime = chrono::duration<double, nano>(benchClock::now() - start).count();
+
+    //values are now only formatted once per run for the output files
+    start = benchClock::now();
+
+    for (int run = 0; run < runs; run++)
+        checksum += simulator.formatRegisters().size() + simulator.formatData().size();
+
+    double outputTime = chrono::duration<double, nano>(benchClock::now() - start).count();
+
+    cout << fixed << setprecision(2)
+         << executed / runs << " instructions per run, " << runs << " runs" << endl
+         << "simulation:             " << simulateTime / executed
+         << " ns per instruction" << endl
+         << "string formatting:      " << insertTime / executed
+         << " ns per instruction (" << CONVERSIONS << " values, previous datapath)" << endl
+         << "table formatting:       " << tableTime / executed
+         << " ns per instruction (" << CONVERSIONS << " values)" << endl
+         << "output formatting:      " << outputTime / executed
+         << " ns per instruction (registers and data memory once per run)" << endl;
+
+    //keeps the formatting loops from being removed
+    if (checksum == 0)
+        cout << endl;
+
+}
+
+mnemonicIndex loadMnemonicIndex(){
+
+    mnemonicIndex index;
+
+    for (const INSTRUCTION_INFO &info : INSTRUCTION_TABLE)
+        index[info.name] = &info;
+
+    return index;
+}
+
+Simulator::Simulator(int exDepth, int version){
+
+    if (version < 1 || version > 3)
+        throw "Version must be 1, 2 or 3";
+
+    if (exDepth < 1)
+        throw "Execute depth must be at least 1";
+
+    this->version = version;
+    this->exDepth = exDepth;
+
+    //versions 1 and 2 have a single execute stage
+    if (version == 1)
+        this->exDepth = POLICY_V1::EX_DEPTH;
+    else if (version == 2)
+        this->exDepth = POLICY_V2::EX_DEPTH;
+
+}
+
+void Simulator::loadProgram(string filename){
+
+    list_0x00.clear();
+    INST_LABEL_INDEX.clear();
+    sourceRows.clear();
+
+    loadInstruction(filename);
+    predecodeInstructions();
+    translateThreaded();
+
+#ifdef NATIVE_TRANSLATION
+    //pipline and batch runs never run native code
+    nativeTranslated = 0;
+#endif
+
+}
+
+void Simulator::reset(){
+
+    //registers and data memory as loaded
+    fill(begin(registers), end(registers), 0);
+    memory.clear();
+    memory.load(DATA_BASE, initialData.words, initialData.size);
+
+    PC = 0;
+
+    //the next checkpoint starts a new file
+    checkpointRecords = 0;
+    dirtyPages.clear();
+
+    resetPipeline();
+
+}
+
+void Simulator::resetPipeline(){
+
+    //empty pipline
+    if_idReg = IF_ID();
+    exLatches.assign(exDepth, EX_LATCH());
+    ex_memReg = EX_MEM();
+    mem_wbReg = MEM_WB();
+
+    if_idNext = if_idReg;
+    exNext = exLatches;
+    ex_memNext = ex_memReg;
+    mem_wbNext = mem_wbReg;
+
+    fw_unit = FORWARD_UNIT();
+    fw_unit.exWrites.assign(exDepth, 0);
+    fw_unit.exReady.assign(exDepth, 0);
+
+    hazard_unit = HAZARD_UNIT();
+
+    pcSrc = 0;
+    ifFlush = 0;
+    pcSrcNext = 0;
+    ifFlushNext = 0;
+    writeRegisterNext = 0;
+    clockCycle = 1;
+    issued = 0;
+
+    //clock tracking and output
+    pendingRows.clear();
+    fill(begin(rowsTracked), end(rowsTracked), 0);
+    rowsWritten = 0;
+
+}
+
+void Simulator::run(string outputFile){
+
+    reset();
+
+    if (binaryTrace) {
+
+        outInst.open(outputFile, ios::binary);
+        writeTraceProgram();
+
+    }
+    else {
+
+        outInst.open(outputFile);
+
+    }
+
+    writeHeader();
+
+    finishRun();
+
+}
+
+void Simulator::resume(string checkpointFile, string outputFile){
+
+    reset();
+
+    uint64_t outputSize = restoreCheckpoint(checkpointFile);
+
+    //rows written after the checkpoint are written again
+    error_code error;
+    filesystem::resize_file(outputFile, outputSize, error);
+
+    if (error) {
+
+        cerr << "Invalid output file " << outputFile << endl;
+        throw "Output file of the checkpoint could not be resized";
+    }
+
+    outInst.open(outputFile, binaryTrace ? ios::app | ios::binary : ios::app);
+
+    finishRun();
+
+}
+
+void Simulator::finishRun(){
+
+    //Runs Pipline
+    runInstructions();
+
+    //remaining instructions are written to the output file
+    writeOutput();
+
+    outInst.close();
+
+}
+
+void Simulator::setCheckpoint(string filename, long long interval){
+
+    if (interval < 1)
+        throw "Checkpoint interval must be at least 1 clock cycle";
+
+    checkpointFile = filename;
+    checkpointInterval = interval;
+    checkpointRecords = 0;
+
+}
+
+template <class T>
+void putBytes(string &record, const T &value){
+
+    record.append(reinterpret_cast<const char *>(&value), sizeof(T));
+
+}
+
+template <class T>
+void getBytes(const char *&pos, const char *end, T &value){
+
+    if (size_t(end - pos) < sizeof(T))
+        throw "Checkpoint file is corrupt";
+
+    memcpy(&value, pos, sizeof(T));
+    pos += sizeof(T);
+
+}
+
+uint64_t Simulator::programHash() const{
+
+    //FNV-1a over every instruction word
+    uint64_t hash = 14695981039346656037ull;
+
+    for (uint32_t word : list_0x00) {
+
+        hash ^= word;
+        hash *= 1099511628211ull;
+
+    }
+
+    return hash;
+}
+
+void Simulator::writeCheckpoint(){
+
+    //output rows before the checkpoint reach the file first
+    outInst.flush();
+    uint64_t outputSize = outInst.tellp();
+
+    bool full = (checkpointRecords == 0);
+    string record;
+
+    //program and pipline the checkpoint belongs to
+    putBytes(record, uint8_t(full));
+    putBytes(record, int32_t(exDepth));
+    putBytes(record, int32_t(version));
+    putBytes(record, programHash());
+    putBytes(record, outputSize);
+
+    //architectural state
+    putBytes(record, registers);
+    putBytes(record, int64_t(clockCycle));
+    putBytes(record, int32_t(PC));
+    putBytes(record, pcSrc);
+    putBytes(record, ifFlush);
+
+
+    //IF_ID holds the index of its instruction, -1 for a nop
+    for (const IF_ID *latch : {&if_idReg, &if_idNext}) {
+
+        int32_t fetched = -1;
+
+        if (latch->fetchedInstruction != &NOP_INSTRUCTION)
+            fetched = latch->fetchedInstruction - decodedInstructions.data();
+
+        putBytes(record, fetched);
+        putBytes(record, latch->stopInstrucions);
+        putBytes(record, latch->nextAddress);
+
+    }
+
+    //the other pipline registers are plain copies
+    for (int latch = 0; latch < exDepth; latch++) {
+
+        putBytes(record, exLatches[latch]);
+        putBytes(record, exNext[latch]);
+
+    }
+
+    putBytes(record, ex_memReg);
+    putBytes(record, ex_memNext);
+    putBytes(record, mem_wbReg);
+    putBytes(record, mem_wbNext);
+
+    //the units are worked out from the pipline registers every clock cycle
+
+    //rows still in the pipline, the ones before are in the output file
+    putBytes(record, int64_t(rowsWritten));
+    putBytes(record, rowsTracked);
+    putBytes(record, uint64_t(pendingRows.size()));
+
+    for (const TRACE_ROW &row : pendingRows)
+        putBytes(record, row);
+
+    //every page for a full checkpoint, the written pages otherwise
+    vector<uint32_t> savedPages;
+
+    if (full) {
+
+        for (size_t page = 0; page < memory.pagesAllocated(); page++)
+            savedPages.push_back(memory.allocatedPage(page));
+
+    }
+    else {
+
+        savedPages.assign(dirtyPages.begin(), dirtyPages.end());
+
+    }
+
+    putBytes(record, uint32_t(savedPages.size()));
+
+    for (uint32_t page : savedPages) {
+
+        putBytes(record, page);
+        record.append(reinterpret_cast<const char *>(memory.pageAt(page << PAGE_BITS))
+                        , PAGE_WORDS * sizeof(uint32_t));
+
+    }
+
+    dirtyPages.clear();
+
+    //a full checkpoint starts the file over
+    ofstream saveCheckpoint(checkpointFile, full ? ios::binary | ios::trunc
+                                                 : ios::binary | ios::app);
+
+    if (full) {
+
+        string header(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+
+        putBytes(header, CHECKPOINT_VERSION);
+        putBytes(header, uint32_t(sizeof(EX_LATCH)));
+        putBytes(header, uint32_t(sizeof(EX_MEM)));
+        putBytes(header, uint32_t(sizeof(MEM_WB)));
+        putBytes(header, uint32_t(sizeof(FORWARD_SELECT)));
+        putBytes(header, uint32_t(sizeof(TRACE_ROW)));
+
+        saveCheckpoint << header;
+
+    }
+
+    string length;
+    putBytes(length, uint64_t(record.size()));
+
+    saveCheckpoint << length << record << length;
+    saveCheckpoint.flush();
+
+    if (saveCheckpoint.fail()) {
+
+        cerr << "Invalid checkpoint file " << checkpointFile << endl;
+        throw "Checkpoint could not be written";
+    }
+
+    checkpointRecords++;
+
+}
+
+uint64_t Simulator::restoreCheckpoint(string filename){
+
+    uint64_t outputSize = 0;
+    int records = 0;
+    size_t validSize = 0;
+
+    {
+
+        MappedFile source(filename);
+
+        //file does not exist
+        if (source.fail()) {
+
+            cerr << "Invalid checkpoint file " << filename << endl;
+            throw "Checkpoint file could not be opened";
+        }
+
+        const char *pos = source.begin();
+        const char *end = source.end();
+
+        //header has to match this build
+        string header(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+
+        putBytes(header, CHECKPOINT_VERSION);
+        putBytes(header, uint32_t(sizeof(EX_LATCH)));
+        putBytes(header, uint32_t(sizeof(EX_MEM)));
+        putBytes(header, uint32_t(sizeof(MEM_WB)));
+        putBytes(header, uint32_t(sizeof(FORWARD_SELECT)));
+        putBytes(header, uint32_t(sizeof(TRACE_ROW)));
+
+        if (size_t(end - pos) < header.size()
+            || memcmp(pos, header.data(), header.size()) != 0) {
+
+            cerr << "Invalid checkpoint file " << filename << endl;
+            throw "Checkpoint file has another format";
+        }
+
+        pos += header.size();
+
+        //replays checkpoints until one is cut off
+        while (size_t(end - pos) >= sizeof(uint64_t)) {
+
+            uint64_t length, trailer;
+            getBytes(pos, end, length);
+
+            if (uint64_t(end - pos) < length + sizeof(uint64_t))
+                break;
+
+            memcpy(&trailer, pos + length, sizeof(uint64_t));
+
+            if (trailer != length)
+                break;
+
+            outputSize = readCheckpoint(pos, pos + length);
+            records++;
+
+            pos += length + sizeof(uint64_t);
+            validSize = pos - source.begin();
+
+        }
+
+    }
+
+    if (records == 0) {
+
+        cerr << "Invalid checkpoint file " << filename << endl;
+        throw "Checkpoint file has no complete checkpoint";
+    }
+
+    //checkpointing into the same file carries on after its last checkpoint
+    if (filename == checkpointFile) {
+
+        error_code error;
+        filesystem::resize_file(filename, validSize, error);
+
+        if (error) {
+
+            cerr << "Invalid checkpoint file " << filename << endl;
+            throw "Checkpoint file could not be resized";
+        }
+
+        checkpointRecords = records;
+
+    }
+
+    return outputSize;
+}
+
+uint64_t Simulator::readCheckpoint(const char *pos, const char *end){
+
+    uint8_t full;
+    int32_t savedDepth, savedVersion;
+    uint64_t savedHash, outputSize;
+
+    getBytes(pos, end, full);
+    getBytes(pos, end, savedDepth);
+    getBytes(pos, end, savedVersion);
+    getBytes(pos, end, savedHash);
+    getBytes(pos, end, outputSize);
+
+    if (savedDepth != exDepth || savedVersion != version || savedHash != programHash())
+        throw "Checkpoint was taken with another program, execute depth or version";
+
+    int32_t value;
+    int64_t savedClock;
+
+    //architectural state
+    getBytes(pos, end, registers);
+    getBytes(pos, end, savedClock);
+    clockCycle = savedClock;
+    getBytes(pos, end, value);
+    PC = value;
+    getBytes(pos, end, pcSrc);
+    getBytes(pos, end, ifFlush);
+
+    for (IF_ID *latch : {&if_idReg, &if_idNext}) {
+
+        int32_t fetched;
+        getBytes(pos, end, fetched);
+
+        if (fetched < -1 || fetched >= int32_t(decodedInstructions.size()))
+            throw "Checkpoint file is corrupt";
+
+        latch->fetchedInstruction = (fetched < 0) ? &NOP_INSTRUCTION
+                                                  : &decodedInstructions[fetched];
+
+        getBytes(pos, end, latch->stopInstrucions);
+        getBytes(pos, end, latch->nextAddress);
+
+    }
+
+    for (int latch = 0; latch < exDepth; latch++) {
+
+        getBytes(pos, end, exLatches[latch]);
+        getBytes(pos, end, exNext[latch]);
+
+    }
+
+    getBytes(pos, end, ex_memReg);
+    getBytes(pos, end, ex_memNext);
+    getBytes(pos, end, mem_wbReg);
+    getBytes(pos, end, mem_wbNext);
+
+    //rows still in the pipline
+    int64_t savedWritten;
+    uint64_t rowCount;
+
+    getBytes(pos, end, savedWritten);
+    rowsWritten = savedWritten;
+    getBytes(pos, end, rowsTracked);
+    getBytes(pos, end, rowCount);
+
+    if (rowCount > uint64_t(end - pos) / sizeof(TRACE_ROW))
+        throw "Checkpoint file is corrupt";
+
+    pendingRows.resize(rowCount);
+
+    for (TRACE_ROW &row : pendingRows)
+        getBytes(pos, end, row);
+
+    for (long long tracked : rowsTracked) {
+
+        if (tracked < rowsWritten || tracked > rowsWritten + int64_t(rowCount))
+            throw "Checkpoint file is corrupt";
+
+    }
+
+    //a full checkpoint holds every page
+    if (full)
+        memory.clear();
+
+    uint32_t pageCount;
+    getBytes(pos, end, pageCount);
+
+    for (uint32_t page = 0; page < pageCount; page++) {
+
+        uint32_t number;
+        getBytes(pos, end, number);
+
+        if (size_t(end - pos) < PAGE_WORDS * sizeof(uint32_t))
+            throw "Checkpoint file is corrupt";
+
+        memcpy(memory.page(number << PAGE_BITS), pos, PAGE_WORDS * sizeof(uint32_t));
+        pos += PAGE_WORDS * sizeof(uint32_t);
+
+    }
+
+    return outputSize;
+}
+
+long long Simulator::runFunctional(){
+
+    reset();
+
+    long long executed = 0;
+
+#ifdef NATIVE_TRANSLATION
+    if (!nativeTranslated) {
+
+        nativeCode.translate(threadedCode);
+        nativeTranslated = 1;
+
+    }
+
+    //native code runs first, the threaded code continues where it stopped
+    if (nativeCode.translated()) {
+
+        NATIVE_CONTEXT context;
+
+        copy(begin(registers), end(registers), context.registers);
+        context.executed = 0;
+        context.directory = memory.root();
+        context.zeroPage = memory.zero();
+        context.memory = &memory;
+
+        PC = nativeCode.run(context);
+
+        copy(begin(context.registers), end(context.registers), registers);
+        executed = context.executed;
+
+    }
+#endif
+
+    return executed + runThreaded<false>(0);
+}
+
+template <bool COUNTED>
+long long Simulator::runThreaded(long long count){
+
+#ifdef THREADED_DISPATCH
+    #define HANDLER(op) handle_##op
+
+    //handler addresses in the order of THREADED_OP, they belong to one
+    //instantiation so only the uncounted one is resolved into the threaded
+    //code and the counted one looks its handlers up
+    static const void *const HANDLERS[] = {
+        &&handle_OP_ADD, &&handle_OP_SUB, &&handle_OP_AND, &&handle_OP_OR
+        , &&handle_OP_SLL, &&handle_OP_SRL, &&handle_OP_MULT
+        , &&handle_OP_ADDI, &&handle_OP_SUBI, &&handle_OP_ANDI, &&handle_OP_ORI
+        , &&handle_OP_SLLI, &&handle_OP_SRLI, &&handle_OP_MULTI
+        , &&handle_OP_LW, &&handle_OP_SW, &&handle_OP_BEQ, &&handle_OP_BNE
+        , &&handle_OP_J, &&handle_OP_NOP, &&handle_OP_HLT
+    };
+
+    #define DISPATCH() \
+        if (COUNTED && executed == count) goto stop; \
+        goto *(COUNTED ? HANDLERS[inst->op] : inst->handler)
+
+    if (!COUNTED && !threadedResolved) {
+
+        for (THREADED_INST &threaded : threadedCode)
+            threaded.handler = HANDLERS[threaded.op];
+
+        threadedResolved = 1;
+    }
+#else
+    #define HANDLER(op) case op
+    #define DISPATCH() goto dispatch
+#endif
+
+    long long executed = 0;
+
+    int32_t *reg = registers;
+
+    const THREADED_INST *inst = &threadedCode[PC];
+
+    //every handler ends by dispatching the next instruction, a counted run
+    //stops there once count instructions have executed
+    DISPATCH();
+
+#ifndef THREADED_DISPATCH
+dispatch:
+    if (COUNTED && executed == count)
+        goto stop;
+
+    switch (inst->op) {
+#endif
+
+    HANDLER(OP_ADD):
+        reg[inst->rd] = ALU(reg[inst->rs], reg[inst->rt], ALU_ADD);
+        inst++; executed++; DISPATCH();
+    HANDLER(OP_SUB):
+        reg[inst->rd] = ALU(reg[inst->rs], reg[inst->rt], ALU_SUB);
+        inst++; executed++; DISPATCH();
+    HANDLER(OP_AND):
+        reg[inst->rd] = ALU(reg[inst->rs], reg[inst->rt], ALU_AND);
+        inst++; executed++; DISPATCH();
+    HANDLER(OP_OR):
+        reg[inst->rd] = ALU(reg[inst->rs], reg[inst->rt], ALU_OR);
+        inst++; executed++; DISPATCH();
+    HANDLER(OP_SLL):
+        reg[inst->rd] = ALU(reg[inst->rs], reg[inst->rt], ALU_SLL);
+        inst++; executed++; DISPATCH();
+    HANDLER(OP_SRL):
+        reg[inst->rd] = ALU(reg[inst->rs], reg[inst->rt], ALU_SRL);
+        inst++; executed++; DISPATCH();
+    HANDLER(OP_MULT):
+        reg[inst->rd] = ALU(reg[inst->rs], reg[inst->rt], ALU_MULT);
+        inst++; executed++; DISPATCH();
+
+    HANDLER(OP_ADDI):
+        reg[inst->rd] = ALU(reg[inst->rs], inst->immediate, ALU_ADD);
+        inst++; executed++; DISPATCH();
+    HANDLER(OP_SUBI):
+        reg[inst->rd] = ALU(reg[inst->rs], inst->immediate, ALU_SUB);
+        inst++; executed++; DISPATCH();
+    HANDLER(OP_ANDI):
+        reg[inst->rd] = ALU(reg[inst->rs], inst->immediate, ALU_AND);
+        inst++; executed++; DISPATCH();
+    HANDLER(OP_ORI):
+        reg[inst->rd] = ALU(reg[inst->rs], inst->immediate, ALU_OR);
+        inst++; executed++; DISPATCH();
+    HANDLER(OP_SLLI):
+        reg[inst->rd] = ALU(reg[inst->rs], inst->immediate, ALU_SLL);
+        inst++; executed++; DISPATCH();
+    HANDLER(OP_SRLI):
+        reg[inst->rd] = ALU(reg[inst->rs], inst->immediate, ALU_SRL);
+        inst++; executed++; DISPATCH();
+    HANDLER(OP_MULTI):
+        reg[inst->rd] = ALU(reg[inst->rs], inst->immediate, ALU_MULT);
+        inst++; executed++; DISPATCH();
+
+    //addresses wrap around the 32 bit address space
+    HANDLER(OP_LW):
+        reg[inst->rd] = memory.read(uint32_t(reg[inst->rs]) + uint32_t(inst->immediate));
+        inst++; executed++; DISPATCH();
+    HANDLER(OP_SW):
+        memory.write(uint32_t(reg[inst->rs]) + uint32_t(inst->immediate), reg[inst->rt]);
+        inst++; executed++; DISPATCH();
+
+    HANDLER(OP_BEQ):
+        executed++;
+        inst = (reg[inst->rs] == reg[inst->rt]) ? inst->target : inst + 1;
+        DISPATCH();
+    HANDLER(OP_BNE):
+        executed++;
+        inst = (reg[inst->rs] != reg[inst->rt]) ? inst->target : inst + 1;
+        DISPATCH();
+    HANDLER(OP_J):
+        executed++;
+        inst = inst->target;
+        DISPATCH();
+
+    HANDLER(OP_NOP):
+        inst++; executed++; DISPATCH();
+
+    HANDLER(OP_HLT):
+    stop:
+        PC = inst - &threadedCode[0];
+
+#ifndef THREADED_DISPATCH
+    }
+#endif
+
+    #undef HANDLER
+    #undef DISPATCH
+
+    return executed;
+}
+
+SAMPLE_STATS Simulator::runSampled(long long period, long long window, long long warmup
+                                    , [[maybe_unused]] int forks){
+
+    if (version == 1)
+        throw "Sampling needs a version that takes branches";
+
+    if (window < 1 || warmup < 0 || period < warmup + window)
+        throw "Sampling period must hold the warm up and the window";
+
+    reset();
+
+    SAMPLE_STATS stats;
+
+    //cycles of each window, -1 when it did not complete
+    vector<long long> windowCycles;
+
+#ifdef FORKED_SAMPLES
+    //children send their results through one pipe
+    int results[2] = {-1, -1};
+    int running = 0;
+
+    if (forks > 1 && pipe(results) == 0)
+        fcntl(results[0], F_SETFL, O_NONBLOCK);
+    else
+        forks = 1;
+#endif
+
+    //a window at the start of every period, the functional mode runs the
+    //whole period so the architectural state stays exact
+    while (1) {
+
+        windowCycles.push_back(-1);
+        int sample = windowCycles.size() - 1;
+
+#ifdef FORKED_SAMPLES
+        pid_t child = -1;
+
+        if (forks > 1) {
+
+            //waits for a child to finish when every fork is in use
+            if (running == forks) {
+
+                reapWindow(results[0], windowCycles);
+                running--;
+
+            }
+
+            cout.flush();
+            child = fork();
+
+            //the child runs its window on a copy of the parent
+            if (child == 0) {
+
+                WINDOW_RESULT result = {sample, -1};
+
+                try {
+
+                    result.cycles = sampleWindow(window, warmup);
+
+                } catch (const char *error) {
+
+                    cerr << "Sampling window " << sample << ": " << error << endl;
+
+                }
+
+                ssize_t written = write(results[1], &result, sizeof(result));
+                _exit(written == sizeof(result) ? 0 : 1);
+
+            }
+
+            if (child > 0)
+                running++;
+
+        }
+
+        //runs the window itself without a child
+        if (child <= 0)
+#endif
+        windowCycles[sample] = sampleWindow(window, warmup);
+
+        long long executed = runThreaded<true>(period);
+        stats.instructions += executed;
+
+        if (executed < period)
+            break;
+
+    }
+
+#ifdef FORKED_SAMPLES
+    if (forks > 1) {
+
+        //every child has written before it exits
+        while (running > 0) {
+
+            reapWindow(results[0], windowCycles);
+            running--;
+
+        }
+
+        close(results[0]);
+        close(results[1]);
+
+    }
+#endif
+
+    //windows are summed in order so forking gives the same report
+    double sum = 0, squares = 0;
+
+    for (long long cycles : windowCycles) {
+
+        if (cycles < 0)
+            continue;
+
+        double cpi = double(cycles) / window;
+
+        sum += cpi;
+        squares += cpi * cpi;
+        stats.samples++;
+
+    }
+
+    if (stats.samples > 0)
+        stats.cpi = sum / stats.samples;
+
+    //standard error of the mean over the windows
+    if (stats.samples > 1) {
+
+        double variance = (squares - sum * sum / stats.samples) / (stats.samples - 1);
+        stats.cpiError = CONFIDENCE_Z * sqrt(max(variance, 0.0) / stats.samples);
+
+    }
+
+    return stats;
+}
+
+#ifdef FORKED_SAMPLES
+void readWindowResults(int results, vector<long long> &windowCycles){
+
+    WINDOW_RESULT result;
+
+    while (read(results, &result, sizeof(result)) == sizeof(result)) {
+
+        if (result.sample >= 0 && result.sample < int64_t(windowCycles.size()))
+            windowCycles[result.sample] = result.cycles;
+
+    }
+
+}
+
+void reapWindow(int results, vector<long long> &windowCycles){
+
+    while (1) {
+
+        readWindowResults(results, windowCycles);
+
+        pid_t child = waitpid(-1, nullptr, WNOHANG);
+
+        if (child != 0) {
+
+            //results written just before the child exited
+            readWindowResults(results, windowCycles);
+            return;
+
+        }
+
+        //sleeps until a result arrives or a moment passes
+        pollfd ready = {results, POLLIN, 0};
+        poll(&ready, 1, 1);
+
+    }
+}
+#endif
+
+long long Simulator::sampleWindow(long long window, long long warmup){
+
+    //architectural state the window starts from
+    int32_t savedRegisters[32];
+    copy(begin(registers), end(registers), savedRegisters);
+    int savedPC = PC;
+
+    resetPipeline();
+
+    sampling = 1;
+    issueLimit = warmup + window;
+    warmupIssued = warmup;
+    warmupCycle = 1;
+
+    runInstructions();
+
+    long long cycles = -1;
+
+    //the last window instructions issued after the warm up
+    if (issued >= issueLimit)
+        cycles = clockCycle - 1 - warmupCycle;
+
+    //stores are undone newest first
+    for (size_t store = undoStores.size(); store > 0; store--)
+        memory.write(get<0>(undoStores[store - 1]), get<1>(undoStores[store - 1]));
+
+    undoStores.clear();
+
+    sampling = 0;
+    issueLimit = 0;
+    warmupIssued = 0;
+
+    copy(begin(savedRegisters), end(savedRegisters), registers);
+    PC = savedPC;
+
+    return cycles;
+}
+
+long long Simulator::runLockstep(const vector<LOCKSTEP_JOB> &jobs){
+
+    long long executed = 0;
+
+    //lanes are reused for each group of contexts
+    LANE_CONTEXTS lanes;
+
+    for (size_t first = 0; first < jobs.size(); first += LOCKSTEP_LANES) {
+
+        int count = min<size_t>(LOCKSTEP_LANES, jobs.size() - first);
+
+        for (int reg = 0; reg < 32; reg++)
+            lanes.registers[reg].fill(0);
+
+        //lanes without a context start halted
+        lanes.pc.fill(INT32_MAX);
+        lanes.otherWords.clear();
+
+        for (int lane = 0; lane < count; lane++) {
+
+            loadData(jobs[first + lane].data);
+
+            if (lane == 0)
+                lanes.data.assign(initialData.size, LANE_WORDS());
+            else if (initialData.size != lanes.data.size())
+                throw "Data files of a lockstep run must have the same size";
+
+            for (size_t word = 0; word < initialData.size; word++)
+                lanes.data[word][lane] = int32_t(initialData.words[word]);
+
+            lanes.pc[lane] = 0;
+
+        }
+
+        executed += runLanes(lanes);
+
+        //each context is written through the simulator's own state
+        for (int lane = 0; lane < count; lane++) {
+
+            for (int reg = 0; reg < 32; reg++)
+                registers[reg] = lanes.registers[reg][lane];
+
+            for (size_t word = 0; word < lanes.data.size(); word++)
+                memory.write(DATA_BASE + word, uint32_t(lanes.data[word][lane]));
+
+            writeRegisterValue(jobs[first + lane].outputPrefix + "register.txt");
+            writeDataValue(jobs[first + lane].outputPrefix + "dataUpdate.txt");
+
+        }
+    }
+
+    return executed;
+}
+
+long long Simulator::runLanes(LANE_CONTEXTS &lanes) const{
+
+    const int HALTED = INT32_MAX;
+
+    long long executed = 0;
+
+    LANE_WORDS mask, value;
+
+    while (true) {
+
+        //lanes that took different branches run separately, the lowest PC
+        //goes first so lanes behind catch up and run together again
+        int pc = HALTED;
+
+        for (int lane = 0; lane < LOCKSTEP_LANES; lane++)
+            pc = min(pc, lanes.pc[lane]);
+
+        if (pc == HALTED)
+            break;
+
+        int active = 0;
+
+        for (int lane = 0; lane < LOCKSTEP_LANES; lane++) {
+
+            mask[lane] = -int32_t(lanes.pc[lane] == pc);
+            active -= mask[lane];
+
+        }
+
+        const THREADED_INST &inst = threadedCode[pc];
+
+        executed += active;
+
+        //next instruction unless a branch is taken
+        value.fill(pc + 1);
+
+        switch (inst.op) {
+
+            case OP_ADD: case OP_SUB: case OP_AND: case OP_OR:
+            case OP_SLL: case OP_SRL: case OP_MULT:
+                laneALU(lanes.registers[inst.rd], lanes.registers[inst.rs]
+                        , lanes.registers[inst.rt], mask, ALU_OP(inst.op - OP_ADD));
+                break;
+
+            case OP_ADDI: case OP_SUBI: case OP_ANDI: case OP_ORI:
+            case OP_SLLI: case OP_SRLI: case OP_MULTI: {
+
+                LANE_WORDS immediate;
+                immediate.fill(inst.immediate);
+
+                laneALU(lanes.registers[inst.rd], lanes.registers[inst.rs]
+                        , immediate, mask, ALU_OP(inst.op - OP_ADDI));
+                break;
+
+            }
+
+            //every lane has its own address
+            case OP_LW: case OP_SW:
+
+                for (int lane = 0; lane < LOCKSTEP_LANES; lane++) {
+
+                    if (!mask[lane])
+                        continue;
+
+                    //addresses wrap like the functional mode's
+                    uint32_t address = uint32_t(lanes.registers[inst.rs][lane])
+                                        + uint32_t(inst.immediate);
+                    uint32_t index = address - DATA_BASE;
+
+                    //makes up for index at 0x100
+                    if (index < lanes.data.size()) {
+
+                        if (inst.op == OP_LW)
+                            lanes.registers[inst.rd][lane] = lanes.data[index][lane];
+                        else
+                            lanes.data[index][lane] = lanes.registers[inst.rt][lane];
+
+                    }
+                    else if (inst.op == OP_LW) {
+
+                        unordered_map<uint32_t, LANE_WORDS>::const_iterator word
+                            = lanes.otherWords.find(address);
+
+                        if (word == lanes.otherWords.end())
+                            lanes.registers[inst.rd][lane] = 0;
+                        else
+                            lanes.registers[inst.rd][lane] = word->second[lane];
+
+                    }
+                    else {
+
+                        //a new word starts as zero in every lane
+                        lanes.otherWords[address][lane] = lanes.registers[inst.rt][lane];
+
+                    }
+
+                }
+                break;
+
+            case OP_BEQ: case OP_BNE: {
+
+                int target = inst.target - &threadedCode[0];
+                bool equalTaken = (inst.op == OP_BEQ);
+
+                for (int lane = 0; lane < LOCKSTEP_LANES; lane++) {
+
+                    bool equal = lanes.registers[inst.rs][lane]
+                                    == lanes.registers[inst.rt][lane];
+
+                    if (equal == equalTaken)
+                        value[lane] = target;
+
+                }
+                break;
+
+            }
+
+            case OP_J:
+                value.fill(inst.target - &threadedCode[0]);
+                break;
+
+            case OP_NOP:
+                break;
+
+            case OP_HLT:
+                value.fill(HALTED);
+                break;
+
+        }
+
+        laneSelect(lanes.pc, value, mask);
+
+    }
+
+    return executed;
+}
+
+int getRegIndex(const string &reg){
+
+    if (reg == "$zero")
+        return 0;
+
+    //every other name is one or two characters after the $
+    if (reg.size() >= 2 && reg.size() <= 3 && reg[0] == '$') {
+
+        uint8_t first = reg[1];
+        uint8_t second = (reg.size() == 3) ? reg[2] : 0;
+
+        if (first < 128 && second < 128 && REGISTER_TABLE[first * 128 + second] >= 0)
+            return REGISTER_TABLE[first * 128 + second];
+
+    }
+
+    cerr << "Unknown register " << reg << endl;
+    throw "Instructions file has an unknown register";
+
+}
+
+char *formatBinary(char *buffer, uint32_t value){
+
+    //one table row per byte, highest byte first
+    for (int shift = BINARY_WORD - 8; shift >= 0; shift -= 8) {
+
+        memcpy(buffer, BINARY_TABLE[(value >> shift) & 0xFF].data(), 8);
+        buffer += 8;
+
+    }
+
+    return buffer;
+}
+
+string insertBinaryStr(int number, int numBits){
+
+    string makeBinary = "";
+    int bit = 0;
+
+    //while number can be divided by 2
+    while (number > 0){
+
+        bit = number % 2;
+        number /= 2;
+
+        //makes binary
+        makeBinary.insert(0, to_string(bit));
+
+    }
+
+    //makes sure binary has the corrct number of bits
+    if (int(makeBinary.size()) > numBits) {
+
+        makeBinary.resize(numBits);
+    }
+    else if (int(makeBinary.size()) < numBits) {
+
+        while (int(makeBinary.size()) != numBits)
+            makeBinary.insert(0, "0");
+
+    }
+
+    return makeBinary;
+}
+
+void Simulator::loadInstruction(string filename){
+
+    MappedFile source(filename);
+
+    //file does not exist
+    if (source.fail()) {
+
+        cerr << "Invalid instructions file " << filename << endl;
+        throw "Instructions file could not be opened";
+    }
+
+    SOURCE_CURSOR cursor = {source.begin(), source.end()};
+
+    //branches and jumps to labels that are not defined yet
+    vector<BACKPATCH> backpatches;
+
+    //labels of the next instruction as its source row lists them, one per
+    //line
+    string rowLabels;
+
+    string getInst, tempInst;
+
+    //while there is something to read
+    while (!(getInst = nextToken(cursor)).empty()) {
+
+        //labels point at the next instruction
+        if (getInst[getInst.size() - 1] == 58) {
+
+            if (!rowLabels.empty())
+                rowLabels += "\n";
+
+            appendPadded(rowLabels, getInst, 10);
+
+            getInst.resize(getInst.size() - 1);
+
+            if (!INST_LABEL_INDEX.emplace(getInst, int(list_0x00.size())).second) {
+
+                cerr << "Duplicate label " << getInst << endl;
+                throw "Label is defined more than once";
+            }
+
+            continue;
+        }
+
+        //converts getInst to uppercase
+        tempInst = getInst;
+
+        for (char &letter : tempInst)
+            letter = toupper(letter);
+
+        //source row starts with the labels and the instruction as written
+        string row = rowLabels.empty() ? string(10, ' ') : rowLabels;
+        rowLabels.clear();
+
+        appendPadded(row, getInst, 10);
+
+        //checks a nop
+        if (tempInst == "NOP") {
+
+            //reads $zero, the operands are optional so only this line is read
+            SOURCE_CURSOR operands = restOfLine(cursor);
+
+            string getReg1 = nextField(operands);
+            string getReg2 = nextField(operands);
+            string getReg3 = nextToken(operands);
+
+            if (getReg1.empty())
+                row.append(24, ' ');
+            else {
+
+                appendPadded(row, getReg1 + ",", 7);
+                appendPadded(row, getReg2 + ",", 7);
+                appendPadded(row, getReg3, 10);
+
+            }
+
+            list_0x00.push_back(0);
+            sourceRows.push_back(row);
+
+            continue;
+        }
+
+        mnemonicIndex::const_iterator found = MNEMONIC_INDEX.find(tempInst);
+
+        if (found == MNEMONIC_INDEX.end()) {
+
+            cerr << "Unknown instruction " << getInst << endl;
+            throw "Instructions file has an unknown instruction";
+        }
+
+        const INSTRUCTION_INFO &info = *found->second;
+
+        //adds opcode
+        uint32_t word = uint32_t(info.opcode) << 26;
+
+        //label of a branch or jump, resolved below
+        string label;
+        uint32_t fieldMask = 0;
+
+        if (info.format == FORMAT_R) {
+
+            string getReg1 = nextField(cursor);
+            string getReg2 = nextField(cursor);
+            string getReg3 = nextToken(cursor);
+
+            //adds rs rt rd, shamt is 0, and funct
+            word |= uint32_t(getRegIndex(getReg2)) << 21;
+            word |= uint32_t(getRegIndex(getReg3)) << 16;
+            word |= uint32_t(getRegIndex(getReg1)) << 11;
+            word |= info.funct;
+
+            appendPadded(row, getReg1 + ",", 7);
+            appendPadded(row, getReg2 + ",", 7);
+            appendPadded(row, getReg3, 10);
+
+        }
+        else if (info.format == FORMAT_I) {
+
+            string getReg1 = nextField(cursor);
+            string getReg2, getCons;
+
+            //li reads from $zero
+            if (tempInst == "LI") {
+
+                getReg2 = "$zero";
+                getCons = nextToken(cursor);
+
+                appendPadded(row, getReg1 + ",", 7);
+                appendPadded(row, getCons, 17);
+
+            }
+            //lw and sw take offset(register)
+            else if (tempInst == "LW" || tempInst == "SW") {
+
+                string temp = nextToken(cursor);
+
+                size_t first_paren = temp.find("(");
+                size_t second_paren = temp.find(")");
+
+                if (first_paren == string::npos || second_paren == string::npos) {
+
+                    cerr << "Invalid address " << temp << endl;
+                    throw "Instructions file has an invalid address";
+                }
+
+                getReg2 = temp.substr(first_paren + 1, second_paren - (first_paren + 1));
+                getCons = temp.substr(0, first_paren);
+
+                appendPadded(row, getReg1 + ",", 7);
+                appendPadded(row, temp, 17);
+
+            }
+            else {
+
+                getReg2 = nextField(cursor);
+                getCons = nextToken(cursor);
+
+                appendPadded(row, getReg1 + ",", 7);
+                appendPadded(row, getReg2 + ",", 7);
+                appendPadded(row, getCons, 10);
+
+            }
+
+            bool branch = (info.control & (CTRL_BRANCH_BEQ | CTRL_BRANCH_BNE));
+
+            //adds rs rt, branches compare rs with rt in source order
+            if (branch) {
+
+                word |= uint32_t(getRegIndex(getReg1)) << 21;
+                word |= uint32_t(getRegIndex(getReg2)) << 16;
+
+            }
+            else {
+
+                word |= uint32_t(getRegIndex(getReg2)) << 21;
+                word |= uint32_t(getRegIndex(getReg1)) << 16;
+
+            }
+
+            //branches always go to a label, even one that reads as hex
+            if (branch) {
+
+                label = getCons;
+                fieldMask = 0xFFFF;
+
+            }
+            //adds constant
+            else
+                word |= parseConstant(getCons);
+        }
+        else if (info.format == FORMAT_J) {
+
+            label = nextToken(cursor);
+            fieldMask = 0x3FFFFFF;
+
+            appendPadded(row, label, 7);
+            row.append(17, ' ');
+
+        }
+        //halt
+        else {
+
+            word = 0xFC000000;
+            row.append(24, ' ');
+
+        }
+
+        if (fieldMask) {
+
+            labelIndex::const_iterator target = INST_LABEL_INDEX.find(label);
+
+            //label is defined later in the file
+            if (target == INST_LABEL_INDEX.end())
+                backpatches.push_back(BACKPATCH{int(list_0x00.size()), label, fieldMask});
+            else
+                word |= uint32_t(target->second) & fieldMask;
+
+        }
+
+        list_0x00.push_back(word);
+        sourceRows.push_back(row);
+
+    }
+
+    //every label is known now
+    for (const BACKPATCH &patch : backpatches) {
+
+        labelIndex::const_iterator target = INST_LABEL_INDEX.find(patch.label);
+
+        if (target == INST_LABEL_INDEX.end()) {
+
+            cerr << "Undefined label " << patch.label << endl;
+            throw "Instructions file uses an undefined label";
+        }
+
+        list_0x00[patch.index] |= uint32_t(target->second) & patch.fieldMask;
+
+    }
+}
+
+string nextToken(SOURCE_CURSOR &cursor){
+
+    while (cursor.pos != cursor.end && isspace(uint8_t(*cursor.pos)))
+        cursor.pos++;
+
+    const char *start = cursor.pos;
+
+    while (cursor.pos != cursor.end && !isspace(uint8_t(*cursor.pos)))
+        cursor.pos++;
+
+    return string(start, cursor.pos);
+}
+
+string nextField(SOURCE_CURSOR &cursor){
+
+    string field;
+
+    while (cursor.pos != cursor.end && *cursor.pos != ',') {
+
+        //remove white space
+        if (!isspace(uint8_t(*cursor.pos)))
+            field.push_back(*cursor.pos);
+
+        cursor.pos++;
+
+    }
+
+    //skips the comma
+    if (cursor.pos != cursor.end)
+        cursor.pos++;
+
+    return field;
+}
+
+SOURCE_CURSOR restOfLine(SOURCE_CURSOR &cursor){
+
+    const char *start = cursor.pos;
+
+    while (cursor.pos != cursor.end && *cursor.pos != '\n')
+        cursor.pos++;
+
+    return SOURCE_CURSOR{start, cursor.pos};
+}
+
+void appendPadded(string &row, const string &text, size_t width){
+
+    row += text;
+
+    //text wider than the column is kept whole
+    if (text.size() < width)
+        row.append(width - text.size(), ' ');
+
+}
+
+uint32_t parseConstant(const string &constant){
+
+    bool hex = !constant.empty() && constant[constant.size() - 1] == 'h';
+    string digits = hex ? constant.substr(0, constant.size() - 1) : constant;
+
+    char *end = nullptr;
+
+    errno = 0;
+    long long value = strtoll(digits.c_str(), &end, hex ? 16 : 10);
+
+    //the whole constant has to be the number, hex has no sign
+    if (digits.empty() || *end != '\0' || errno == ERANGE
+        || (hex && !isxdigit(uint8_t(digits[0])))
+        || value < (hex ? 0 : -32768) || value > 0xFFFF) {
+
+        cerr << "Invalid constant " << constant << endl;
+        throw "Instructions file has a constant that is not a 16 bit number";
+    }
+
+    //two's complement
+    return uint32_t(value) & 0xFFFF;
+}
+
+PagedMemory::PagedMemory(){
+
+    fill(begin(zeroTable), end(zeroTable), &zeroPage[0]);
+    fill(begin(directory), end(directory), &zeroTable[0]);
+
+}
+
+uint32_t *PagedMemory::page(uint32_t address){
+
+    uint32_t **&table = directory[address >> (PAGE_BITS + TABLE_BITS)];
+
+    //first write to the table's 8 MiB
+    if (table == zeroTable) {
+
+        tables.emplace_back(new uint32_t *[TABLE_PAGES]);
+        table = tables.back().get();
+        fill(table, table + TABLE_PAGES, &zeroPage[0]);
+
+    }
+
+    uint32_t *&entry = table[(address >> PAGE_BITS) & (TABLE_PAGES - 1)];
+
+    //first write to the page, it starts zero filled
+    if (entry == zeroPage) {
+
+        pages.emplace_back(new uint32_t[PAGE_WORDS]());
+        pageNumbers.push_back(address >> PAGE_BITS);
+        entry = pages.back().get();
+
+    }
+
+    return entry;
+}
+
+void PagedMemory::load(uint32_t address, const uint32_t *words, size_t count){
+
+    //copies up to the end of each page
+    while (count > 0) {
+
+        size_t offset = address & (PAGE_WORDS - 1);
+        size_t length = min(count, size_t(PAGE_WORDS) - offset);
+
+        memcpy(page(address) + offset, words, length * sizeof(uint32_t));
+
+        address += length;
+        words += length;
+        count -= length;
+
+    }
+
+}
+
+void PagedMemory::clear(){
+
+    pages.clear();
+    pageNumbers.clear();
+    tables.clear();
+
+    fill(begin(directory), end(directory), &zeroTable[0]);
+
+}
+
+MappedFile::MappedFile(const string &filename){
+
+#ifdef MAPPED_FILES
+    int file = open(filename.c_str(), O_RDONLY);
+
+    if (file < 0) {
+
+        failed = 1;
+        return;
+
+    }
+
+    struct stat info;
+
+    if (fstat(file, &info) == 0 && info.st_size > 0) {
+
+        void *view = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+
+        if (view != MAP_FAILED) {
+
+            data = static_cast<const char *>(view);
+            size = info.st_size;
+            mapped = 1;
+
+        }
+    }
+
+    close(file);
+
+    if (mapped)
+        return;
+#endif
+
+    //reads the whole file when it cannot be mapped
+    ifstream loadFile(filename, ios::binary);
+
+    if (loadFile.fail()) {
+
+        failed = 1;
+        return;
+
+    }
+
+    buffer.assign(istreambuf_iterator<char>(loadFile), istreambuf_iterator<char>());
+
+    data = buffer.data();
+    size = buffer.size();
+
+}
+
+MappedFile::~MappedFile(){
+
+#ifdef MAPPED_FILES
+    if (mapped)
+        munmap(const_cast<char *>(data), size);
+#endif
+
+}
+
+void Simulator::predecodeInstructions(){
+
+    decodedInstructions.clear();
+    decodedInstructions.reserve(list_0x00.size() + 1);
+
+    //decodes each instruction word once
+    for (int i = 0; i < int(list_0x00.size()); i++) {
+
+        decodedInstructions.push_back(predecode(list_0x00[i]));
+
+    }
+
+    //extra halt for running past the last instruction
+    decodedInstructions.push_back(predecode(0xFC000000));
+
+}
+
+void Simulator::translateThreaded(){
+
+    int size = list_0x00.size();
+
+    //extra halt for running past the last instruction
+    threadedCode.assign(size + 1, THREADED_INST());
+    threadedResolved = 0;
+
+    for (int i = 0; i < size; i++) {
+
+        const DECODED_INST &inst = decodedInstructions[i];
+        THREADED_INST &threaded = threadedCode[i];
+
+        uint16_t control = inst.control.control;
+
+        threaded.rs = inst.rs;
+        threaded.rt = inst.rt;
+        threaded.immediate = inst.instrutction15_0;
+
+        if (inst.halt) {
+
+            threaded.op = OP_HLT;
+
+        }
+        else if (control & (CTRL_BRANCH_BEQ | CTRL_BRANCH_BNE | CTRL_JUMP)) {
+
+            int target = inst.nextAddress;
+
+            if (control & CTRL_BRANCH_BEQ)
+                threaded.op = OP_BEQ;
+            else if (control & CTRL_BRANCH_BNE)
+                threaded.op = OP_BNE;
+            else {
+                threaded.op = OP_J;
+                target = inst.jumpAddress;
+            }
+
+            //targets outside instruction memory halt
+            if (target > size)
+                target = size;
+
+            threaded.target = &threadedCode[target];
+
+        }
+        else if (control & CTRL_MEM_WRITE) {
+
+            threaded.op = OP_SW;
+
+        }
+        else if (!(control & CTRL_REG_WRITE)) {
+
+            threaded.op = OP_NOP;
+
+        }
+        else {
+
+            threaded.rd = (control & CTRL_REG_DST) ? inst.rd : inst.rt;
+
+            //writes to $zero are dropped
+            if (threaded.rd == 0)
+                threaded.op = OP_NOP;
+            else if (control & CTRL_MEM_READ)
+                threaded.op = OP_LW;
+            else if (control & CTRL_ALU_SRC)
+                threaded.op = THREADED_OP(OP_ADDI + inst.control.aluOp);
+            else
+                threaded.op = THREADED_OP(OP_ADD + inst.control.aluOp);
+
+        }
+    }
+}
+
+#ifdef NATIVE_TRANSLATION
+
+//x86-64 registers used by translated code
+const int X86_EAX = 0, X86_ECX = 1, X86_EDX = 2, X86_EDI = 7;
+
+NativeCode::~NativeCode(){
+
+    release();
+
+}
+
+void NativeCode::release(){
+
+    if (code != nullptr)
+        munmap(code, codeSize);
+
+    code = nullptr;
+    codeSize = 0;
+
+}
+
+void NativeCode::emit(initializer_list<uint8_t> bytes){
+
+    buffer.insert(buffer.end(), bytes);
+
+}
+
+void NativeCode::emitInt(int32_t value){
+
+    uint8_t bytes[4];
+    memcpy(bytes, &value, 4);
+
+    buffer.insert(buffer.end(), bytes, bytes + 4);
+
+}
+
+void NativeCode::emitContext(initializer_list<uint8_t> opcode, int reg, int offset){
+
+    //modrm with a 32 bit displacement from rdi
+    emit(opcode);
+    emit({uint8_t(0x87 | (reg << 3))});
+    emitInt(offset);
+
+}
+
+bool NativeCode::translate(const vector<THREADED_INST> &threadedCode){
+
+    release();
+    buffer.clear();
+
+    //last instruction is the halt added by translateThreaded
+    int size = threadedCode.size() - 1;
+    const THREADED_INST *first = &threadedCode[0];
+
+    //blocks start at the first instruction, at branch targets and after
+    //branches
+    vector<bool> leader(size + 1, 0);
+    leader[0] = 1;
+    leader[size] = 1;
+
+    for (int i = 0; i < size; i++) {
+
+        if (threadedCode[i].target != nullptr) {
+
+            leader[threadedCode[i].target - first] = 1;
+            leader[i + 1] = 1;
+
+        }
+    }
+
+    vector<int> blockStart(size + 1, -1);
+
+    //jumps to blocks, offset of the jump - instruction index of the block
+    vector<tuple<int, int>> patches;
+
+    const int REGISTER_OFFSET = offsetof(NATIVE_CONTEXT, registers);
+    const int EXECUTED_OFFSET = offsetof(NATIVE_CONTEXT, executed);
+    const int DIRECTORY_OFFSET = offsetof(NATIVE_CONTEXT, directory);
+    const int ZERO_OFFSET = offsetof(NATIVE_CONTEXT, zeroPage);
+    const int MEMORY_OFFSET = offsetof(NATIVE_CONTEXT, memory);
+
+    //mov rsi, [rdi + directory], the page directory stays in rsi
+    emitContext({0x48, 0x8B}, 6, DIRECTORY_OFFSET);
+
+    for (int i = 0; i <= size; i++) {
+
+        const THREADED_INST &inst = threadedCode[i];
+
+        int rs = REGISTER_OFFSET + 4 * inst.rs;
+        int rt = REGISTER_OFFSET + 4 * inst.rt;
+        int rd = REGISTER_OFFSET + 4 * inst.rd;
+
+        if (leader[i]) {
+
+            blockStart[i] = buffer.size();
+
+            //counts the instructions of the block, a halt is not counted
+            int end = i;
+
+            while (end < size && threadedCode[end].op != OP_HLT) {
+
+                end++;
+
+                if (threadedCode[end - 1].target != nullptr || leader[end])
+                    break;
+
+            }
+
+            //add qword [rdi + executed], count
+            if (end > i) {
+
+                emitContext({0x48, 0x81}, 0, EXECUTED_OFFSET);
+                emitInt(end - i);
+
+            }
+        }
+
+        switch (inst.op) {
+
+            //op eax, [rs] then op eax, [rt]
+            case OP_ADD:
+            case OP_SUB:
+            case OP_AND:
+            case OP_OR:
+            case OP_MULT:
+                emitContext({0x8B}, X86_EAX, rs);
+
+                if (inst.op == OP_ADD)
+                    emitContext({0x03}, X86_EAX, rt);
+                else if (inst.op == OP_SUB)
+                    emitContext({0x2B}, X86_EAX, rt);
+                else if (inst.op == OP_AND)
+                    emitContext({0x23}, X86_EAX, rt);
+                else if (inst.op == OP_OR)
+                    emitContext({0x0B}, X86_EAX, rt);
+                else
+                    emitContext({0x0F, 0xAF}, X86_EAX, rt);
+
+                emitContext({0x89}, X86_EAX, rd);
+                break;
+
+            //shifts by cl, the cpu keeps the low 5 bits like ALU()
+            case OP_SLL:
+            case OP_SRL:
+                emitContext({0x8B}, X86_EAX, rs);
+                emitContext({0x8B}, X86_ECX, rt);
+                emit({0xD3, uint8_t(inst.op == OP_SLL ? 0xE0 : 0xE8)});
+                emitContext({0x89}, X86_EAX, rd);
+                break;
+
+            //op eax, constant
+            case OP_ADDI:
+            case OP_SUBI:
+            case OP_ANDI:
+            case OP_ORI:
+            case OP_MULTI:
+                emitContext({0x8B}, X86_EAX, rs);
+
+                if (inst.op == OP_ADDI)
+                    emit({0x05});
+                else if (inst.op == OP_SUBI)
+                    emit({0x2D});
+                else if (inst.op == OP_ANDI)
+                    emit({0x25});
+                else if (inst.op == OP_ORI)
+                    emit({0x0D});
+                else
+                    emit({0x69, 0xC0});
+
+                emitInt(inst.immediate);
+                emitContext({0x89}, X86_EAX, rd);
+                break;
+
+            case OP_SLLI:
+            case OP_SRLI:
+                emitContext({0x8B}, X86_EAX, rs);
+                emit({0xC1, uint8_t(inst.op == OP_SLLI ? 0xE0 : 0xE8)
+                        , uint8_t(inst.immediate & 0x1F)});
+                emitContext({0x89}, X86_EAX, rd);
+                break;
+
+            //word address in eax, its page in rdx
+            case OP_LW:
+            case OP_SW:
+                emitContext({0x8B}, X86_EAX, rs);
+                emit({0x05});
+                emitInt(inst.immediate);
+
+                //mov edx, eax, shr edx, table and page bits
+                //mov rdx, [rsi + rdx*8]
+                emit({0x89, 0xC2, 0xC1, 0xEA, uint8_t(PAGE_BITS + TABLE_BITS)});
+                emit({0x48, 0x8B, 0x14, 0xD6});
+
+                //mov ecx, eax, shr ecx, page bits, and ecx, table mask
+                //mov rdx, [rdx + rcx*8]
+                emit({0x89, 0xC1, 0xC1, 0xE9, uint8_t(PAGE_BITS), 0x81, 0xE1});
+                emitInt(TABLE_PAGES - 1);
+                emit({0x48, 0x8B, 0x14, 0xCA});
+
+                //a store to the zero page first allocates its page
+                if (inst.op == OP_SW) {
+
+                    //cmp rdx, [rdi + zero page], jne over the call
+                    emitContext({0x48, 0x3B}, X86_EDX, ZERO_OFFSET);
+                    emit({0x75, 0x00});
+                    int skip = buffer.size();
+
+                    //push rdi, push rsi, push rax keeps rsp 16 byte aligned
+                    emit({0x57, 0x56, 0x50});
+
+                    //rdx = nativeTouchPage([rdi + memory], eax)
+                    emitContext({0x48, 0x8B}, X86_EDI, MEMORY_OFFSET);
+                    emit({0x89, 0xC6, 0x48, 0xB8});
+
+                    uint64_t touch = reinterpret_cast<uint64_t>(&nativeTouchPage);
+                    uint8_t bytes[8];
+                    memcpy(bytes, &touch, 8);
+                    buffer.insert(buffer.end(), bytes, bytes + 8);
+
+                    emit({0xFF, 0xD0, 0x48, 0x89, 0xC2});
+
+                    //pop rax, pop rsi, pop rdi
+                    emit({0x58, 0x5E, 0x5F});
+
+                    buffer[skip - 1] = uint8_t(buffer.size() - skip);
+
+                }
+
+                //and eax, page mask
+                emit({0x25});
+                emitInt(PAGE_WORDS - 1);
+
+                //mov eax, [rdx + rax*4]
+                if (inst.op == OP_LW) {
+
+                    emit({0x8B, 0x04, 0x82});
+                    emitContext({0x89}, X86_EAX, rd);
+
+                }
+                //mov [rdx + rax*4], ecx
+                else {
+
+                    emitContext({0x8B}, X86_ECX, rt);
+                    emit({0x89, 0x0C, 0x82});
+
+                }
+                break;
+
+            //cmp then je/jne to the target, not taken falls into the next block
+            case OP_BEQ:
+            case OP_BNE:
+                emitContext({0x8B}, X86_EAX, rs);
+                emitContext({0x3B}, X86_EAX, rt);
+                emit({0x0F, uint8_t(inst.op == OP_BEQ ? 0x84 : 0x85)});
+                patches.push_back(tuple<int, int>(buffer.size(), inst.target - first));
+                emitInt(0);
+                break;
+
+            case OP_J:
+                emit({0xE9});
+                patches.push_back(tuple<int, int>(buffer.size(), inst.target - first));
+                emitInt(0);
+                break;
+
+            case OP_NOP:
+                break;
+
+            //mov eax, index then ret
+            case OP_HLT:
+                emit({0xB8});
+                emitInt(i);
+                emit({0xC3});
+                break;
+
+        }
+    }
+
+    //chains jumps to their blocks
+    for (const tuple<int, int> &patch : patches) {
+
+        int offset = get<0>(patch);
+        int32_t distance = blockStart[get<1>(patch)] - (offset + 4);
+
+        memcpy(&buffer[offset], &distance, 4);
+
+    }
+
+    //copies the code into executable memory
+    codeSize = buffer.size();
+    code = mmap(nullptr, codeSize, PROT_READ | PROT_WRITE
+                , MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (code == MAP_FAILED) {
+
+        code = nullptr;
+        codeSize = 0;
+        return 0;
+
+    }
+
+    memcpy(code, buffer.data(), codeSize);
+    buffer.clear();
+    buffer.shrink_to_fit();
+
+    if (mprotect(code, codeSize, PROT_READ | PROT_EXEC) != 0) {
+
+        release();
+        return 0;
+
+    }
+
+    return 1;
+}
+
+uint32_t *nativeTouchPage(PagedMemory *memory, uint32_t address){
+
+    return memory->page(address);
+
+}
+
+int NativeCode::run(NATIVE_CONTEXT &context) const{
+
+    return nativeEntry(code)(&context);
+
+}
+
+#endif
+
+DECODED_INST predecode(uint32_t instruction){
+
+    DECODED_INST inst;
+
+    //controls from the control table
+    inst.instruction = instruction;
+    inst.control = controlFor(instruction >> 26, instruction & 0x3F);
+
+    //checks if halt
+    if (inst.control.control & CTRL_HALT) {
+
+        inst.halt = 1;
+        return inst;
+
+    }
+
+    //rs, rt and rd
+    inst.rs = (instruction >> 21) & 0x1F;
+    inst.rt = (instruction >> 16) & 0x1F;
+    inst.rd = (instruction >> 11) & 0x1F;
+
+    //sign extends constant/address to 32 bits
+    int32_t constant = int16_t(instruction & 0xFFFF);
+
+    //if lw or sw
+    if (inst.control.control & (CTRL_MEM_READ | CTRL_MEM_WRITE)) {
+
+        //makes up word difference in address
+        constant /= 4;
+
+    }
+    //andi and ori use a zero extended constant
+    else if (inst.control.control & CTRL_ZERO_EXTEND) {
+
+        constant = instruction & 0xFFFF;
+
+    }
+
+    inst.instrutction15_0 = constant;
+
+    //jump and conditional addresses
+    inst.nextAddress = instruction & 0xFFFF;
+    inst.jumpAddress = instruction & 0x3FFFFFF;
+
+    return inst;
+
+}
+
+void Simulator::loadData(string filename){
+
+    unique_ptr<MappedFile> source(new MappedFile(filename));
+
+    //if file does not exist
+    if (source->fail()) {
+
+        cerr << "Invalid data file " << filename << endl;
+        throw "Data file could not be opened";
+    }
+
+    const char *pos = source->begin();
+    const char *end = source->end();
+
+    parsedData.clear();
+    mappedData.reset();
 
-        //Loading instructions and registers
-        loadInstrucionList();
-        loadRegister();
+    //binary image, words in the byte order of the host
+    if (filename.size() > 4 && filename.compare(filename.size() - 4, 4, ".bin") == 0) {
 
-        //Parsing instructions
-        loadInstruction(argv[1]);
+        if ((end - pos) % sizeof(uint32_t) != 0) {
 
-        //Populating data memory
-        loadData(argv[2]);
+            cerr << "Invalid data image " << filename << endl;
+            throw "Data image size is not a multiple of a word";
+        }
 
-        outputFile = argv[3];
-        instructionFile = argv[1];
+        initialData.size = (end - pos) / sizeof(uint32_t);
 
-        outInst.open(outputFile);
+        //a mapping is page aligned so its words are used in place
+        if (reinterpret_cast<uintptr_t>(pos) % alignof(uint32_t) == 0) {
 
-        //Runs Pipline
-        runInstructions();
-        finishedInst = 1; 
+            initialData.words = reinterpret_cast<const uint32_t *>(pos);
+            mappedData = move(source);
 
-        //project output is written to files
-        writeOutput(instructionFile);  
+        }
+        else {
 
-        outInst.close();
-        writeRegisterValue();
-        writeDataValue();
+            parsedData.resize(initialData.size);
+            memcpy(parsedData.data(), pos, initialData.size * sizeof(uint32_t));
+            initialData.words = parsedData.data();
 
-    } catch (const char* error){
+        }
 
-        cout << "Error: "<< error << endl;
-        cout << "Example: inst.txt data.txt output.txt" << endl;
+        memory.clear();
+        memory.load(DATA_BASE, initialData.words, initialData.size);
 
-    }
+        return;
 
-}
+    }
 
-void loadInstrucionList(){
+    //text words are 32 digits and a line break
+    parsedData.reserve((end - pos) / (BINARY_WORD + 1) + 1);
 
-    //Insert R type instructions, instruction - opcode - funct
-    R_INSTRUCTION_LIST.push_back(tuple<string,string,string> ("ADD", "000000", "100000"));
-    R_INSTRUCTION_LIST.push_back(tuple<string,string,string> ("SUB", "000000", "100010"));
-    R_INSTRUCTION_LIST.push_back(tuple<string,string,string> ("AND", "000000", "100100"));
-    R_INSTRUCTION_LIST.push_back(tuple<string,string,string> ("OR", "000000", "100101"));
-    R_INSTRUCTION_LIST.push_back(tuple<string,string,string> ("SLL", "000000", "000000"));
-    R_INSTRUCTION_LIST.push_back(tuple<string,string,string> ("SRL", "000000", "000010"));
-    R_INSTRUCTION_LIST.push_back(tuple<string,string,string> ("MULT", "000000", "011000"));
+    //while not at end of file
+    while (pos != end) {
 
-    //Insert I type instructions, instruction - opcode
-    I_INSTRUCTION_LIST.push_back(tuple<string,string> ("LW", "100011"));
-    I_INSTRUCTION_LIST.push_back(tuple<string,string> ("SW", "101011"));
-    I_INSTRUCTION_LIST.push_back(tuple<string,string> ("LI", "001011")); 
-    I_INSTRUCTION_LIST.push_back(tuple<string,string> ("ADDI", "001000"));
-    I_INSTRUCTION_LIST.push_back(tuple<string,string> ("SUBI", "100001")); 
-    I_INSTRUCTION_LIST.push_back(tuple<string,string> ("ANDI", "001100"));
-    I_INSTRUCTION_LIST.push_back(tuple<string,string> ("ORI", "001101"));
-    I_INSTRUCTION_LIST.push_back(tuple<string,string> ("BEQ", "000100"));
-    I_INSTRUCTION_LIST.push_back(tuple<string,string> ("BNE", "000101"));
-    I_INSTRUCTION_LIST.push_back(tuple<string,string> ("SLLI", "010010")); 
-    I_INSTRUCTION_LIST.push_back(tuple<string,string> ("SRLI", "000011"));
-    I_INSTRUCTION_LIST.push_back(tuple<string,string> ("MULTI", "001001"));
+        //skips whitespace between words
+        if (*pos == ' ' || *pos == '\t' || *pos == '\r' || *pos == '\n') {
 
-}
+            pos++;
+            continue;
 
-void loadRegister(){
+        }
 
-    //Inserts needed register names to represent index
-    LIST_REG_INDEX.push_back(tuple<string,int> ("$zero", 0));
-    registers[0] = 0;
+        uint32_t word = 0;
+        int digits = 0;
 
-    LIST_REG_INDEX.push_back(tuple<string,int> ("$at", 1));
-    LIST_REG_INDEX.push_back(tuple<string,int> ("$gp", 28));
-    LIST_REG_INDEX.push_back(tuple<string,int> ("$sp", 29));
-    LIST_REG_INDEX.push_back(tuple<string,int> ("$fp", 30));
-    LIST_REG_INDEX.push_back(tuple<string,int> ("$ra", 31));
+        //shifts in each digit of the word
+        while (pos != end && (*pos == '0' || *pos == '1')) {
 
-}
+            word = (word << 1) | uint32_t(*pos - '0');
+            digits++;
+            pos++;
 
-int getRegIndex(string reg){
+        }
 
-    for (vector<tuple<string,int>>::iterator i = LIST_REG_INDEX.begin()
-                                    ; i != LIST_REG_INDEX.end(); ++i) {
+        //word has to end at whitespace and fit in 32 bits
+        if (digits == 0 || digits > BINARY_WORD || (pos != end && *pos != ' '
+                && *pos != '\t' && *pos != '\r' && *pos != '\n')) {
 
-        //if register is found
-        if (reg == get<0>(*i)){
+            cerr << "Invalid data word " << parsedData.size() << " in " << filename << endl;
+            throw "Data file has an invalid word";
+        }
 
-            //return index
-            return get<1>(*i);
+        //adds data word to data memory
+        parsedData.push_back(word);
 
-       }
     }
 
-    //gets the number from register's thrid index
-    //example $s8, gets 8 and converts to int
-    int addIndex = (int)reg[2] - 48;
+    initialData.words = parsedData.data();
+    initialData.size = parsedData.size();
 
-    int index = 0;
+    memory.clear();
+    memory.load(DATA_BASE, initialData.words, initialData.size);
+}
 
-    //finding index that represents the register integer
-    if (reg[1] == 'v') {
+void Simulator::writeOutput() {
 
-        index = INDEX_V;
+    //rows of instructions that did not reach write back, with the stages
+    //they did reach
+    for (const TRACE_ROW &row : pendingRows)
+        writeRow(row);
 
-    }
-    else if (reg[1] == 'a') {
+    rowsWritten += pendingRows.size();
+    pendingRows.clear();
 
-        index = INDEX_A;
+}
 
-    }
-    else if (reg[1] == 't') {
+void Simulator::trackFetch(int pc){
 
-        //checks for temporary's integer
-        if (addIndex >= 8) {
-            addIndex -= 8;
-            index = INDEX_T8;
-        }
-        else
-            index = INDEX_T0;
+    TRACE_ROW row;
+    row.pc = pc;
 
-    }
-    else if (reg[1] == 's'){
+    pendingRows.push_back(row);
 
-        index = INDEX_S;
+    trackClock(COLUMN_IF, clockCycle);
 
-    }
-    else if (reg[1] == 'k'){
+}
 
-        index = INDEX_K;
+void Simulator::trackClock(int column, int clock){
 
-    }
-    
-    //returns computed index
-    return (index + addIndex);
+    //stages track rows in the order they were fetched
+    TRACE_ROW &row = pendingRows[rowsTracked[column] - rowsWritten];
 
-}
+    row.clocks[column] = clock;
+    row.columns |= 1 << column;
+    rowsTracked[column]++;
 
-string decimalToBinaryStr (int number, int numBits){
+    //write back is the last stage, the row is written as it retires
+    if (column == COLUMN_WB) {
 
-    string makeBinary = "";
-    int bit = 0;
+        //a sampling window does not write output
+        if (!sampling)
+            writeRow(row);
 
-    //while number can be divided by 2
-    while (number > 0){
+        pendingRows.pop_front();
+        rowsWritten++;
 
-        bit = number % 2;
-        number /= 2;
+    }
+}
 
-        //makes binary
-        makeBinary.insert(0, to_string(bit));
+void Simulator::writeRow(const TRACE_ROW &row){
 
-    }
+    if (row.pc >= int(sourceRows.size()))
+        return;
 
-    //makes sure binary has the corrct number of bits
-    if (int(makeBinary.size()) > numBits) {            
+    if (binaryTrace)
+        writeTraceRecord(row);
+    else
+        writeTableRow(outInst, sourceRows[row.pc], row.clocks, row.columns);
 
-        makeBinary.resize(numBits);
-    }
-    else if (int(makeBinary.size()) < numBits) {
+}
 
-        while (int(makeBinary.size()) != numBits)
-            makeBinary.insert(0, "0");
+void Simulator::writeHeader(){
 
-    }
+    if (binaryTrace)
+        outInst.put(char(TRACE_HEADER));
+    else
+        writeTableHeader(outInst);
 
-    return makeBinary;
 }
 
-void loadInstruction(string filename){
+void Simulator::writeTraceProgram(){
 
-    ifstream loadInst;
-    loadInst.open(filename);
+    string header(TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    putBytes(header, TRACE_VERSION);
+    putBytes(header, uint32_t(sourceRows.size()));
 
-    //file does not exist
-    if (loadInst.fail()) {
+    //each instruction word and its source row
+    for (size_t row = 0; row < sourceRows.size(); row++) {
 
-        cerr << "Invalid instructions file " << filename << endl;
-        exit(0);
-    }
+        putBytes(header, row < list_0x00.size() ? list_0x00[row] : uint32_t(0));
+        putBytes(header, uint32_t(sourceRows[row].size()));
+        header += sourceRows[row];
 
-    string getInst;
+    }
 
-    int size = 0;
+    outInst << header;
 
-    //goes over instructions for labels indexes
-    while(loadInst >> getInst) {
+}
 
-        if (getInst[getInst.size() - 1] == 58) {
+void Simulator::writeTraceRecord(const TRACE_ROW &row){
 
-            //gets label
-            getInst.resize(getInst.size() - 1);
-            INST_LABEL_INDEX.push_back(tuple<string,int>(getInst, size));
+    //flags, PC and IF cycle then the later stages as an offset from IF
+    char record[2 + 10 * (TRACE_COLUMNS + 1)];
+    char *pos = record + 1;
 
-        }
+    const int *clocks = row.clocks;
+    uint8_t columns = row.columns;
 
-        string tempInst;
+    uint8_t flags = columns;
+    int fetched = clocks[0];
 
-        //converts getInst to uppercase
-        for (int i = 0; i < int(getInst.length()); i ++){
+    pos = putVarint(pos, row.pc);
+    pos = putVarint(pos, fetched);
 
-            tempInst.push_back(toupper(getInst[i]));
+    for (int track = 1; track < TRACE_COLUMNS; track++) {
 
-        }
+        if (!(columns & (1 << track)))
+            continue;
 
-        getInst = tempInst;
-        tempInst = "";
+        //0 is a squashed stage, others are stored one past the offset
+        if (clocks[track] == 0) {
 
-        //checking for number of instructions
-        for (vector<tuple<string,string,string>>::iterator i = R_INSTRUCTION_LIST.begin()
-                                                    ; i != R_INSTRUCTION_LIST.end(); ++i){
-            if (getInst == get<0>(*i)) {
-                size++;
-            }
+            flags |= TRACE_FLUSHED;
+            pos = putVarint(pos, 0);
 
         }
+        else {
 
-        for (vector<tuple<string,string>>::iterator i = I_INSTRUCTION_LIST.begin()
-                                            ; i != I_INSTRUCTION_LIST.end(); ++i){
-            
-            if (getInst == get<0>(*i)) {
-                size++;
-            }
-        }
+            pos = putVarint(pos, uint64_t(int64_t(clocks[track]) - fetched + 1));
 
-        if (getInst == "J" || getInst == "HLT" || getInst =="NOP")
-            size++;
-        
+        }
     }
 
-    //resetting ifstream
-    loadInst.close();
-    loadInst.open(filename);
+    if ((columns & 2) && clocks[1] > fetched + 1)
+        flags |= TRACE_STALLED;
 
-    string getReg1, getReg2, getReg3, getCons;
-    string shamt;
+    record[0] = char(flags);
 
-    string temp, tempInst;
-    string tempBinary = "";
+    outInst.write(record, pos - record);
 
-    //while there is something to read
-    while (loadInst >> getInst) {
-        
-        //checks for labels
-        while (getInst[getInst.size() - 1] == 58) {
+}
 
-            //skips over labels
-            loadInst >> getInst;
+char *putVarint(char *pos, uint64_t value){
 
-        }
+    while (value >= 0x80) {
 
-        //converts getInst to uppercase
-        for (int i = 0; i < int(getInst.length()); i ++){
+        *pos++ = char(0x80 | (value & 0x7F));
+        value >>= 7;
 
-            tempInst.push_back(toupper(getInst[i]));
+    }
 
-        }
+    *pos++ = char(value);
 
-        getInst = tempInst;
-        tempInst = "";
-        
-        //checks instruction in R_INSTRUCTIONS
-        for (vector<tuple<string,string,string>>::iterator i = R_INSTRUCTION_LIST.begin()
-                                                    ; i != R_INSTRUCTION_LIST.end(); ++i){
-            
-            if (getInst == get<0>(*i)) {
-                
-                //adds opcode
-                tempBinary.append(get<1>(*i));
-                
-                //gets register1
-                getline(loadInst, getReg1, ',');
-                
-                //remove white space
-                getReg1.erase(remove_if(getReg1.begin(), getReg1.end(), ::isspace), getReg1.end());
+    return pos;
+}
 
-                //gets register2
-                getline(loadInst, getReg2, ',');
+uint64_t getVarint(const char *&pos, const char *end){
 
-                //remove white space
-                getReg2.erase(remove_if(getReg2.begin(), getReg2.end(), ::isspace), getReg2.end());
+    uint64_t value = 0;
 
-                //gets register3
-                loadInst >> getReg3;
+    for (int shift = 0; shift < 64; shift += 7) {
 
-                //adds rs rt and rd
-                tempBinary.append(decimalToBinaryStr(getRegIndex(getReg2), 5));
-                tempBinary.append(decimalToBinaryStr(getRegIndex(getReg3), 5));
-                tempBinary.append(decimalToBinaryStr(getRegIndex(getReg1), 5));
+        if (pos == end)
+            throw "Trace file is corrupt";
 
-                shamt = "00000";
-                
-                //adds shamt and funct
-                tempBinary.append(shamt);
-                tempBinary.append(get<2>(*i));
+        uint8_t byte = *pos++;
+        value |= uint64_t(byte & 0x7F) << shift;
 
-            }
-        }
+        if (!(byte & 0x80))
+            return value;
 
-        //checks instruction in I_INSTRUCTIONS
-        for (vector<tuple<string,string>>::iterator i = I_INSTRUCTION_LIST.begin()
-                                            ; i != I_INSTRUCTION_LIST.end(); ++i){
-            
-            if (getInst == get<0>(*i)) {
-                
-                //adds opcode
-                tempBinary.append(get<1>(*i));
-                
-                //gets register1
-                getline(loadInst, getReg1, ',');
+    }
 
-                //remove white space
-                getReg1.erase(remove_if(getReg1.begin(), getReg1.end(), ::isspace), getReg1.end());
-                
-                //if instruction is li
-                if (getInst == "LI") {
+    throw "Trace file is corrupt";
+}
 
-                    getReg2 = "00000";
+void writeTableHeader(ostream &out){
 
-                }
-                //if instructions is lw or sw
-                else if (getInst == "LW" || getInst == "SW") {
-                    
-                    loadInst >> temp;
-
-                    int first_paren = temp.find("(");
-                    int second_paren = temp.find(")");
-                    
-                    //gets register2 for lw or sw
-                    getReg2 = temp.substr(first_paren + 1, (second_paren - (first_paren + 1)));
-                    
-                    //remove white space
-                    getReg2.erase(remove_if(getReg2.begin(), getReg2.end(), ::isspace), getReg2.end());
-                    
+    out.width(66);
+    out << right << "IF   ID   EX   MEM  WB";
+    out << "\n";
 
-                }
-                else {
-                    
-                    //gets register2
-                    getline(loadInst, getReg2, ',');
+}
 
-                    //remove white space
-                    getReg2.erase(remove_if(getReg2.begin(), getReg2.end(), ::isspace), getReg2.end());
-                    
-                }
+void writeTableRow(ostream &out, const string &sourceRow, const int *clocks
+                    , uint8_t columns){
 
-                if (getInst == "LW" || getInst == "SW") {
-                    //gets constant for lw or sw 
-                    getCons = temp.substr(0, temp.find("("));
+    out << sourceRow;
 
-                    //remove white space
-                    getCons.erase(remove_if(getCons.begin(), getCons.end(), ::isspace), getCons.end());
-                }
-                else {
+    //inserts clock cycle from each stage
+    for (int track = 0; track < TRACE_COLUMNS; track++) {
 
-                    //gets constant/address
-                    loadInst >> getCons;
-                    
-                }
+        if (!(columns & (1 << track)))
+            continue;
 
-                //adds rs rt
-                if (getInst == "BEQ" || getInst == "BNE") {
-                    
-                    tempBinary.append(decimalToBinaryStr(getRegIndex(getReg1), 5));
-                    tempBinary.append(decimalToBinaryStr(getRegIndex(getReg2), 5));
+        out.width(5);
 
-                }
-                else {
-                    
-                    tempBinary.append(decimalToBinaryStr(getRegIndex(getReg2), 5));
-                    tempBinary.append(decimalToBinaryStr(getRegIndex(getReg1), 5));
-                
-                }
+        //if tracking during nop
+        if (clocks[track] == 0)
+            out << left << "";
+        else
+            out << left << clocks[track];
 
-                //check if hex
-                if (getCons[getCons.size() - 1] == 'h') {
+    }
 
-                    //converts to hex    
-                    getCons.replace(getCons.size() - 1, 1 , "");
-                    getCons.insert(0, "0x");
-                    
-                    //adds constant
-                    tempBinary.append(decimalToBinaryStr(stoi(getCons, nullptr, 16), 16));
+    out << "\n";
 
-                } 
-                else {
-                    
-                    if (getInst == "BEQ" || getInst == "BNE") {
-                        
-                        //checks for label index
-                        for (int i = 0; i < int(INST_LABEL_INDEX.size()); i++) {
-                            
-                            if (get<0>(INST_LABEL_INDEX[i]) == getCons) 
-                                //adds label index
-                                tempBinary.append(decimalToBinaryStr(get<1>(INST_LABEL_INDEX[i]), 16));
-                                
-                        }
-                    }
-                    else {
+}
 
-                        string makeNegative;
-                        //adds constant
-                        if (stoi(getCons) < 0) {
+void renderTrace(string traceFile, string outputFile){
 
-                            getCons.replace(0, 1, "");
-                            makeNegative = "1";
-                        }
-                        else {
+    MappedFile source(traceFile);
 
-                            makeNegative = "0";
+    //file does not exist
+    if (source.fail()) {
 
-                        }
+        cerr << "Invalid trace file " << traceFile << endl;
+        throw "Trace file could not be opened";
+    }
 
-                        makeNegative.append(decimalToBinaryStr(stoi(getCons), 15));
-                        tempBinary.append(makeNegative);
-                    
-                    }
-                    
-                }
-            }
-        }
+    const char *pos = source.begin();
+    const char *end = source.end();
 
-        //checks for jump instruction
-        if (getInst == "J") {
-
-            //adds opcode
-            tempBinary.append("000010");
-            loadInst >> getCons;
-
-            //looks for label in list
-            for (int i = 0; i < int(INST_LABEL_INDEX.size()); i++) {
-                            
-                if (get<0>(INST_LABEL_INDEX[i]) == getCons) {
-                                
-                    //gets label index
-                    getCons = decimalToBinaryStr(get<1>(INST_LABEL_INDEX[i]), 26);
-                                
-                }
-            }
-            tempBinary.append(getCons);
-        }
+    if (size_t(end - pos) < sizeof(TRACE_MAGIC)
+        || memcmp(pos, TRACE_MAGIC, sizeof(TRACE_MAGIC)) != 0) {
 
-        //if instruction is to halt
-        if (getInst == "HLT") {
+        cerr << "Invalid trace file " << traceFile << endl;
+        throw "Trace file has another format";
+    }
 
-            list_0x00.push_back("11111100000000000000000000000000");
+    pos += sizeof(TRACE_MAGIC);
 
-        }
-        //checks a nop
-        else if (getInst == "NOP") {
+    uint32_t version, rowCount;
+    getBytes(pos, end, version);
 
-            //reads $zero
-            loadInst >> temp;
-            loadInst >> temp;
-            loadInst >> temp;
-            list_0x00.push_back("00000000000000000000000000000000");
+    if (version != TRACE_VERSION) {
 
-        }
-        else {
-            list_0x00.push_back(tempBinary);
-        }
-        
-        tempBinary = "";
+        cerr << "Invalid trace file " << traceFile << endl;
+        throw "Trace file has another format";
     }
 
-    loadInst.close();
-}
+    //source rows of the program, the words are not needed for the table
+    getBytes(pos, end, rowCount);
+    vector<string> sourceRows(rowCount);
 
-void loadData(string filename){
+    for (string &row : sourceRows) {
 
-    ifstream loadData;
-    loadData.open(filename);
+        uint32_t word, length;
+        getBytes(pos, end, word);
+        getBytes(pos, end, length);
 
-    //if file does not exist
-    if (loadData.fail()) {
+        if (size_t(end - pos) < length)
+            throw "Trace file is corrupt";
+
+        row.assign(pos, length);
+        pos += length;
 
-        cerr << "Invalid data file " << filename << endl;
-        exit(0);
     }
 
-    string getData;
+    ofstream outInst(outputFile);
 
-    //while not at end of file
-    while (loadData >> getData){
-        
-        //adds data to data memory
-        list_0x100.push_back(getData);
+    //every record is a header or a row
+    while (pos != end) {
 
-    }
+        uint8_t flags = *pos++;
 
-    loadData.close();
-}
+        if (flags & TRACE_HEADER) {
 
-void writeOutput(string filename) {
+            writeTableHeader(outInst);
+            continue;
 
-    ifstream loadInst;
-    loadInst.open(filename);
+        }
 
-    //file does not exist
-    if (loadInst.fail()) {
+        uint64_t index = getVarint(pos, end);
 
-        cerr << "Invalid instructions file " << filename << endl;
-        exit(0);
-    }
+        if (index >= sourceRows.size())
+            throw "Trace file is corrupt";
 
-    string getFirst, getInst, temp;
-    int index = 0;
-    
-    int tempAddress = 0;
+        int clocks[TRACE_COLUMNS] = {};
+        clocks[0] = getVarint(pos, end);
 
-    //header
-    if (finishedInst && !writtenHeader){
-        
-        outInst.width(66);
-        outInst << right << "IF   ID   EX   MEM  WB";
-        outInst << "\n";
+        for (int track = 1; track < TRACE_COLUMNS; track++) {
 
+            if (!(flags & (1 << track)))
+                continue;
 
-    }
-    //first flushing is written to output file
-    else if (!firstFlush) {
+            uint64_t offset = getVarint(pos, end);
 
-        outInst.width(66);
-        outInst << right << "IF   ID   EX   MEM  WB";
-        outInst << "\n";
-        writtenHeader = 1;
+            if (offset != 0)
+                clocks[track] = int(int64_t(clocks[0]) + int64_t(offset) - 1);
 
-        tempAddress = 0;
-    }
+        }
 
-    //flushing when first flush has been written
-    if (mem_wbReg.writeFlushed && firstFlush) {
+        writeTableRow(outInst, sourceRows[index], clocks, flags & ((1 << TRACE_COLUMNS) - 1));
 
-        tempAddress = holdAddress; 
-         
     }
-    //finished instruction
-    else if (finishedInst){
 
-        tempAddress = holdAddress; 
-        prevPC++;
-        holdPrevPC = prevPC;
-        
-    }   
+}
 
-    //while there are instructions to read
-    while (loadInst >> getFirst) {
-        
-        //writting within the proper indexes
-        if (index >= tempAddress && index <= holdPrevPC) {    
-            
-            //at label
-            if (getFirst[getFirst.size() - 1] == 58) {
-                
-                //insert label 
-                outInst.width(10); 
-                outInst << left << getFirst;
-                
-                loadInst >> getFirst;
+void Simulator::writeRegisterValue(string filename) const{
 
-                while (getFirst[getFirst.size() - 1] == 58) {
+    ofstream outReg(filename);
 
-                    outInst << "\n";
+    outReg << formatRegisters();
 
-                    //insert next label
-                    outInst.width(10); 
-                    outInst << left << getFirst;
+}
 
-                    loadInst >> getFirst;
+void Simulator::writeDataValue(string filename) const{
 
-                }
+    ofstream outData(filename);
 
-                //inserts instructions
-                outInst.width(10);
-                outInst << left << getFirst;
+    outData << formatData();
 
-            }
-            else {
-        
-                //insert instruction
-                outInst.width(10);
-                outInst << left << "";
-                outInst.width(10);
-                outInst << left << getFirst;
+}
 
-            }
+string Simulator::formatRegisters() const{
+
+    string text;
+    char line[16 + BINARY_WORD];
+    uint32_t num;
 
-            temp = "";
-            //converts to uppercase
-            for (int i = 0; i < int(getFirst.length()); i ++){
+    //register values, negative values are written as a sign and magnitude
+    for (int i = 0; i < 32; i++) {
 
-                temp.push_back(toupper(getFirst[i]));
+        char *end = line + snprintf(line, sizeof(line), "%%%d = ", i);
 
-            }
+        num = registers[i];
 
-            getFirst = temp;
-            temp = "";
+        if (registers[i] < 0) {
 
-            //checks end instruction call
-            if (getFirst == "HLT") {
-                
-                //inserts spacing
-                outInst.width(24);
-                outInst << left << "";
-            
-            } 
-            else {
+            *end++ = '-';
+            num = -num;
 
-                //load register1
-                getline(loadInst, getInst, ',');
+        }
 
-                //remove white space
-                getInst.erase(remove_if(getInst.begin(), getInst.end(), ::isspace), getInst.end());
-            
-                outInst.width(7);
-                getInst.append(",");
-                outInst << left << getInst;
+        end = formatBinary(end, num);
+        *end++ = '\n';
 
-            
-                //checks specific instruction call
-                if (getFirst == "LW" || getFirst == "SW" || getFirst == "LI" || getFirst == "J") {
-                    
-                    //gets next part of instruction
-                    loadInst >> getInst;
+        text.append(line, end);
 
-                    outInst.width(17);
+    }
 
-                    //jump instruction
-                    if (getFirst == "J")
-                        outInst << left << "";
-                    else
-                        outInst << left << getInst;
+    return text;
+}
 
-                }
-                else {
+string Simulator::formatData() const{
 
-                    getline(loadInst, getInst, ',');
+    //every word is a line of its bits
+    string text(initialData.size * (BINARY_WORD + 1), '\n');
+    char *line = &text[0];
 
-                    //remove white space
-                    getInst.erase(remove_if(getInst.begin(), getInst.end(), ::isspace), getInst.end());
+    //the words of the loaded data file
+    for (size_t word = 0; word < initialData.size; word++)
+        line = formatBinary(line, memory.read(DATA_BASE + word)) + 1;
 
-                    //inserts next two instrucions
-                    outInst.width(7);
-                    getInst.append(",");
-                    outInst << left << getInst;
+    return text;
+}
 
-                    loadInst >> getInst;
-        
-                    outInst.width(10); 
-                    outInst << left << getInst;
+template <class POLICY>
+void Simulator::runStage(int stage){
+
+    //finds stage to run
+    if (stage == FETCH)
+        instructionFetch<POLICY>();
+    else if (stage == DECODE)
+        instructionDecode<POLICY>();
+    else if (stage < accessStage())
+        execute<POLICY>(stage - DECODE);
+    else if (stage == accessStage())
+        accessMemory();
+    else if (stage == writeBackStage())
+        writeBack();
 
-                }
-                
-            }
+}
 
-            //inserts clock cycle from each stage
-            if (trackIndex < int(trackIFClock.size())) {
+void Simulator::runInstructions() {
 
-                outInst.width(5);
+    //picks the instantiation of the simulated version
+    if (version == 1)
+        runPipeline<POLICY_V1>();
+    else if (version == 2)
+        runPipeline<POLICY_V2>();
+    else
+        runPipeline<POLICY_V3>();
 
-                //if tracking during nop
-                if (trackIFClock.at(trackIndex) == 0)
-                    outInst << left << "";
-                else
-                    outInst << left << trackIFClock.at(trackIndex);
+}
 
-            }
-            if (trackIndex < int(trackIDClock.size())) {
+template <class POLICY>
+void Simulator::runPipeline() {
 
-                outInst.width(5);
+    static_assert(POLICY::FORWARDING || !POLICY::HAZARDS
+                    , "hazard unit only stalls for what forwarding cannot cover");
+    static_assert(POLICY::BRANCH_STAGE == 0 || POLICY::BRANCH_STAGE == DECODE
+                    , "branches are only resolved in ID");
 
-                //if tracking during nop
-                if (trackIDClock.at(trackIndex) == 0)
-                    outInst << left << "";
-                else
-                    outInst << left << trackIDClock.at(trackIndex);
+    //a fixed depth lets the execute loop unroll
+    const int depth = POLICY::EX_DEPTH ? POLICY::EX_DEPTH : exDepth;
+    int lastStage = writeBackStage();
 
-            }
-            if (trackIndex < int(trackEXClock.size())) {
+    //stages in the order they are called when shuffling
+    vector<int> stageOrder;
+    mt19937 shuffleOrder(stageShuffle);
 
-                outInst.width(5);
+    for (int stage = FETCH; stage <= lastStage; stage++)
+        stageOrder.push_back(stage);
 
-                //if tracking during nop
-                if (trackEXClock.at(trackIndex) == 0)
-                    outInst << left << "";
-                else
-                    outInst << left << trackEXClock.at(trackIndex);
+    //while instruct is not halted and the instructions before HLT have
+    //results to write
+    while (!if_idReg.stopInstrucions || pendingWrites()) {
 
-            }
-            if (trackIndex < int(trackMEMClock.size())) {
-                
-                outInst.width(5);
+        if (POLICY::FORWARDING || POLICY::HAZARDS)
+            updateUnits<POLICY>();
 
-                //if tracking during nop
-                if (trackMEMClock.at(trackIndex) == 0)
-                    outInst << left << "";
-                else
-                    outInst << left << trackMEMClock.at(trackIndex);
+        //stages only read the current pipline registers and write the next
+        //copies, the register file and the branch decision, so any order
+        //gives the same clock cycle
+        if (stageShuffle) {
 
-            }
-            if (trackIndex < int(trackWBClock.size())) {
-                
-                outInst.width(5);
+            shuffle(stageOrder.begin(), stageOrder.end(), shuffleOrder);
 
-                //if tracking during nop
-                if (trackWBClock.at(trackIndex) == 0)
-                    outInst << left << "";
-                else
-                    outInst << left << trackWBClock.at(trackIndex);
+            for (int stage : stageOrder) {
+
+                if (stage <= clockCycle)
+                    runStage<POLICY>(stage);
 
             }
-           
-            trackIndex++;
-            outInst << "\n";
-        
         }
-        else {
-            
-            //gets rest of instructions
-            if (getFirst[getFirst.size() - 1] != 58)
-                getline(loadInst, temp);
+        else if (clockCycle >= lastStage) {
 
-            temp = "";
-            
-        }
-        index++;
-        
-    }  
+            writeBack();
+            accessMemory();
 
-    //indicates the first flush
-    if (mem_wbReg.writeFlushed)
-        firstFlush = 1;
+            for (int stage = 2; stage <= depth; stage++)
+                execute<POLICY>(stage);
 
-    loadInst.close();
-}
+            execute<POLICY>(1);
 
-void writeRegisterValue(){
+            instructionDecode<POLICY>();
+            instructionFetch<POLICY>();
 
-    ofstream outReg("register.txt");
+        }
+        else {
 
-    string registerValue = "";
-    int num;
+            //stage runs once the first instruction reaches it
+            for (int stage = lastStage; stage >= FETCH; stage--) {
 
-    //writes register values
-    for (int i = 0; i < 32; i++) {
+                if (stage <= clockCycle)
+                    runStage<POLICY>(stage);
 
-        num = registers[i];
+            }
+        }
 
-        if (registers[i] < 0) {
+        commitLatches();
+        clockCycle++;
 
-            registerValue = "-";
-            num *= -1;
+        if (checkpointInterval && clockCycle % checkpointInterval == 0)
+            writeCheckpoint();
 
-        }
-        else {
+        //sampling window is complete
+        if (issueLimit && issued >= issueLimit)
+            break;
 
-            registerValue = "";
+    }
+}
 
-        }
+bool Simulator::pendingWrites() const{
 
-        registerValue.append(decimalToBinaryStr(num, 32));
+    for (const EX_LATCH &reg : exLatches) {
 
-        outReg << "%"<< i << " = " 
-        << registerValue << endl;
+        if (registerBit(reg.control & CTRL_REG_WRITE, reg.regDestination)
+            || (reg.control & CTRL_MEM_WRITE))
+            return true;
 
     }
 
+    return registerBit(ex_memReg.control & CTRL_REG_WRITE, ex_memReg.regDestination)
+            || (ex_memReg.control & CTRL_MEM_WRITE)
+            || registerBit(mem_wbReg.control & CTRL_REG_WRITE, mem_wbReg.regDestination);
 }
 
-void writeDataValue(){
+void Simulator::commitLatches(){
 
-    ofstream outData("dataUpdate.txt");
+    if_idReg = if_idNext;
+    exLatches = exNext;
+    ex_memReg = ex_memNext;
+    mem_wbReg = mem_wbNext;
 
-    //writes data memory
-    for (int i = 0; i <  int(list_0x100.size()); i++) {
+    //cannot write to $zero
+    if (writeRegisterNext != 0) {
 
-        outData << list_0x100.at(i) << endl;
+        registers[writeRegisterNext] = writeDataNext;
+        writeRegisterNext = 0;
 
     }
+
+    //IF follows the branch decision the next clock cycle
+    pcSrc = pcSrcNext;
+    ifFlush = ifFlushNext;
+
 }
 
-void insertQueue(){
+template <class POLICY>
+void Simulator::updateUnits(){
 
-    //inserts functions queue with respect to clock cycle
-    queueInstructions.push_back(tuple<int,int> (FETCH, clockCycle));
-    queueInstructions.push_back(tuple<int,int> (DECODE, clockCycle + 1));
-    queueInstructions.push_back(tuple<int,int> (EXECUTE_1, clockCycle + 2));
-    queueInstructions.push_back(tuple<int,int> (EXECUTE_2, clockCycle + 3));
-    queueInstructions.push_back(tuple<int,int> (EXECUTE_3, clockCycle + 4));
-    queueInstructions.push_back(tuple<int,int> (ACCESS, clockCycle + 5));
-    queueInstructions.push_back(tuple<int,int> (WRITE_BACK, clockCycle + 6));
+    //forwarding
+    fw_unit.mem_wbWrites = registerBit(mem_wbReg.control & CTRL_REG_WRITE
+                                        , mem_wbReg.regDestination);
+    fw_unit.ex_memWrites = registerBit(ex_memReg.control & CTRL_REG_WRITE
+                                        , ex_memReg.regDestination);
 
-}
+    bool ex_memLoads = ex_memReg.control & CTRL_MEM_READ;
+    fw_unit.ex_memReady = ex_memLoads ? 0 : fw_unit.ex_memWrites;
 
-void runInstructions() {
+    //hazard, a register only counts in the newest latch writing it
+    uint32_t newerWrites = 0;
 
-    //starts queue
-    insertQueue();
+    hazard_unit.pendingNow = 0;
+    hazard_unit.pendingNext = 0;
 
-    //while instruct is not halted
-    while (!if_idReg.stopInstrucions) {
+    for (int latch = 0; latch < exDepth; latch++) {
 
-        //loops through queue
-        for (vector<tuple<int,int>>::iterator i = queueInstructions.begin()
-                                    ; i != queueInstructions.end(); ++i) {
+        const EX_LATCH &reg = exLatches[latch];
+        uint32_t writes = registerBit(reg.control & CTRL_REG_WRITE, reg.regDestination);
 
-            //checks if stage needs to be executed given clock cycle
-            if (get<1>(*i) == clockCycle) {
-                
-                //finds stage to run
-                if (get<0>(*i) == FETCH) {
-                    instructionFetch();
-                }
-                else if (get<0>(*i) == DECODE){
-                    instructionDecode();
-                }
-                else if (get<0>(*i) == EXECUTE_1){
-                    execute_iu1();       
-                }
-                else if (get<0>(*i) == EXECUTE_2){
-                    execute_iu2();       
-                }
-                else if (get<0>(*i) == EXECUTE_3){
-                    execute_iu3();       
-                }
-                else if (get<0>(*i) == ACCESS){
-                    accessMemory();    
-                }
-                else if (get<0>(*i) == WRITE_BACK){
-                    writeBack();
-                }
-                
-                //removes stage
-                queueInstructions.erase(i);
-                i--;
-                
-            }
-        }
+        //latch k was written by IU k, it holds the result once the IU the
+        //instruction executes in has run, the next latch has it a clock
+        //cycle later
+        bool loads = reg.control & CTRL_MEM_READ;
+        bool readyNow = !loads && reg.execute_inst <= latch;
+        bool readyNext = !loads && reg.execute_inst <= latch + 1;
 
-        clockCycle++;
+        fw_unit.exWrites[latch] = writes;
+        fw_unit.exReady[latch] = readyNow ? writes : 0;
+
+        if (!readyNow)
+            hazard_unit.pendingNow |= writes & ~newerWrites;
 
-        //stops queue 
-        if (!if_idReg.stopInstrucions)
-            insertQueue();
+        if (!readyNext)
+            hazard_unit.pendingNext |= writes & ~newerWrites;
+
+        newerWrites |= writes;
 
     }
+
+    if (ex_memLoads)
+        hazard_unit.pendingNow |= fw_unit.ex_memWrites & ~newerWrites;
+
+    if (POLICY::HAZARDS)
+        hazardDetection<POLICY>();
+
 }
 
-void instructionFetch(){
+template <class POLICY>
+void Simulator::instructionFetch(){
 
-    //stop fetching when HLT is called in decode
-    if (!if_idReg.stopInstrucions) {
+    //nothing is fetched while the instructions before HLT drain
+    if (if_idReg.stopInstrucions)
+        return;
 
-        if (hazard_unit.PCWrite) {
-            
-            //gets instruction memory
-            if (id_iu1Reg.jump) {
-                
-                prevPC = PC;
-                PC = id_iu1Reg.jumpAddress;
-                if_idReg.fetchedInstruction = list_0x00[PC];
-               
-            }
-            else if (pcSrc) {
+    //row of the output the fetch is tracked in
+    int fetchedPC = PC;
 
-                prevPC = PC;
-                PC = id_iu1Reg.nextAddress;
-                if_idReg.fetchedInstruction = list_0x00[PC];
+    //stop fetching when HLT is called in decode
+    bool halting = !ifFlush && if_idReg.fetchedInstruction->halt;
 
-            }
-            else {
-                
-                prevPC = PC;
-                if_idReg.fetchedInstruction = list_0x00[PC];
-                PC++;
+    if (!halting && hazard_unit.PCWrite) {
 
-            }
+        //branch or jump taken last clock cycle is in ID_IU1
+        if (POLICY::BRANCH_STAGE && ifFlush) {
 
-            //passes address
-            if_idReg.nextAddress = PC;
-        }
+            const EX_LATCH &id_iu1Reg = exLatches[0];
 
-    }
+            if (pcSrc)
+                PC = id_iu1Reg.nextAddress;
+            else
+                PC = id_iu1Reg.jumpAddress;
 
+            fetchedPC = PC;
 
-    //flush detected
-    if (ifFlush) {
-        
-        if_idReg.writeFlushed = 1;
+        }
 
-        holdAddress = if_idReg.nextAddress;
-        holdPrevPC = prevPC;
-        
-        //flushes with a nop instruction
-        if_idReg.fetchedInstruction = "00000000000000000000000000000000";
-        
-        //nops
-        id_iu1Reg.idNOP = 1;
-        id_iu1Reg.exNOP = 1;
-        id_iu1Reg.memNOP = 1;
-        id_iu1Reg.wbNOP = 1;
+        //addresses past the last instruction fetch the halt after it, like
+        //the functional mode
+        if (PC >= int(list_0x00.size()))
+            PC = list_0x00.size();
 
-    }
-    else {
+        //gets instruction memory
+        if_idNext.fetchedInstruction = &decodedInstructions[PC];
+        PC++;
+
+        //passes address
+        if_idNext.nextAddress = PC;
 
-        if_idReg.writeFlushed = 0;
-    
     }
 
     //hazard not detected
     if (!hazard_unit.stall)
-        trackIFClock.push_back(clockCycle);
+        trackFetch(fetchedPC);
     
 }
 
-void instructionDecode(){
+template <class POLICY>
+void Simulator::instructionDecode(){
 
-    //updates controls id_iu1Reg
-    string opcode = if_idReg.fetchedInstruction.substr(0,6);
+    EX_LATCH &id_iu1Reg = exNext[0];
 
-    //checks if halt
-    if (opcode == "111111") {
+    //a fetch behind a branch or jump taken last clock cycle is flushed with
+    //a nop
+    bool flushed = POLICY::BRANCH_STAGE && ifFlush;
 
-        if_idReg.stopInstrucions = true;
+    //predecoded fields of the fetched instruction
+    const DECODED_INST &inst = flushed ? NOP_INSTRUCTION : *if_idReg.fetchedInstruction;
 
-    }
-    else {
+    //branch decision IF follows the next clock cycle
+    pcSrcNext = 0;
+    ifFlushNext = 0;
 
-        string getFunct = if_idReg.fetchedInstruction.substr(26,6);
+    //checks if halt, the instructions before it drain behind bubbles
+    if (inst.halt || if_idReg.stopInstrucions) {
 
-        //gets rs 
-        string register1 = if_idReg.fetchedInstruction.substr(6,5); 
-        string readData1 = "0";
+        EX_LATCH bubble;
 
-        int checkValue1 = registers[stoi(register1,nullptr,2)];
+        bubble.idNOP = 1;
+        bubble.exNOP = 1;
+        bubble.memNOP = 1;
+        bubble.wbNOP = 1;
 
-        if (checkValue1 < 0){
+        id_iu1Reg = bubble;
 
-            checkValue1 *= -1;
-            readData1 = "1";
+        if (!if_idReg.stopInstrucions) {
 
-        }
+            if_idNext.stopInstrucions = true;
+            trackClock(COLUMN_ID, clockCycle);
 
-        readData1.append(decimalToBinaryStr(checkValue1, 31));
-        id_iu1Reg.readData1 = readData1;
+        }
 
-        //gets rt
-        string register2 = if_idReg.fetchedInstruction.substr(11,5);
-        string readData2 = "0";
-        
-        int checkValue2 = registers[stoi(register2,nullptr,2)];
+    }
+    else {
 
-        if (checkValue2 < 0){
+        //gets rs 
+        int register1 = inst.rs;
+        int32_t readData1 = readRegister(inst.rs);
 
-            checkValue2 *= -1;
-            readData2 = "1";
+        id_iu1Reg.readData1 = readData1;
 
-        }
+        //gets rt
+        int register2 = inst.rt;
+        int32_t readData2 = readRegister(inst.rt);
 
-        readData2.append(decimalToBinaryStr(checkValue2, 31));
         id_iu1Reg.readData2 = readData2;
 
-        //gets rd in R format
-        id_iu1Reg.instrutction15_11 = if_idReg.fetchedInstruction.substr(16,5);
-
-        //rd in I format
-        id_iu1Reg.instrutction20_16 = if_idReg.fetchedInstruction.substr(11,5);
-
-        //hazard checking
-        hazard_unit.if_idRegisterRs = register1;
-        hazard_unit.if_idRegisterRt = register2;
-    
-        hazardDetection();
-
         //hazarded detected
         if (hazard_unit.stall) {
 
             //sets controls to 0
-            id_iu1Reg.regDst = 0;
-            id_iu1Reg.aluSrc = 0;
-            id_iu1Reg.memToReg = 0;
-            id_iu1Reg.regWrite = 0;
-            id_iu1Reg.memRead = 0;
-            id_iu1Reg.memWrite = 0;
-            id_iu1Reg.branchBEQ = 0;
-            id_iu1Reg.branchBNE = 0;
-            id_iu1Reg.jump = 0;
-
-            id_iu1Reg.aluOp = "000";
+            id_iu1Reg.control = 0;
+
+            id_iu1Reg.aluOp = ALU_ADD;
 
             id_iu1Reg.idNOP = 1;
             id_iu1Reg.exNOP = 1;
@@ -1464,90 +4725,55 @@ void instructionDecode(){
 
         } else {
 
-            //populates control values in id_iu1 register
-            makeControl(opcode, getFunct);
-
-            //not flushing
-            if (!ifFlush) {
-                id_iu1Reg.idNOP = 0;
-                id_iu1Reg.exNOP = 0;
-                id_iu1Reg.memNOP = 0;
-                id_iu1Reg.wbNOP = 0;
-            }
-            
-
-        }
+            //a flushed fetch is not an instruction
+            if (!flushed) {
 
-        //forwards values to ID stage
-        fw_unit.registerRs = register1;
-        fw_unit.registerRt = register2;
-        fw_unit.forwardID = 1;
-        
-        forwarding();
-        
-        if (fw_unit.forwardA == "010"){
-            readData1 = iu2_iu3Reg.aluResult;
-        }
-        else if (fw_unit.forwardA == "011"){
-            readData1 = iu1_iu2Reg.aluResult;
-        }
-        else if (fw_unit.forwardA == "100"){
-            readData1 = iu3_memReg.aluResult;
-        }
-        else if (fw_unit.forwardA == "001"){
-            readData1 = mem_wbReg.muxALU;  
-        }
-        
+                issued++;
 
-        if (fw_unit.forwardB == "010"){
-            readData2 = iu2_iu3Reg.aluResult;
-        }
-        else if (fw_unit.forwardB == "011"){
-            readData2 = iu1_iu2Reg.aluResult;
-        }
-        else if (fw_unit.forwardB == "100"){
-            readData2 = iu3_memReg.aluResult;
-        }
-        else if (fw_unit.forwardB == "001"){
-            readData2 = mem_wbReg.muxALU;  
-        }
-        
+                if (issued == warmupIssued)
+                    warmupCycle = clockCycle;
 
-        string tempString = if_idReg.fetchedInstruction.substr(16,16);
-        int tempConst;
+            }
 
-        //if lw or sw
-        if (opcode == "100011" || opcode == "101011") {
+            //populates control values in id_iu1 register
+            id_iu1Reg.control = inst.control.control;
 
-            int negativeValue = 1;
+            id_iu1Reg.aluOp = inst.control.aluOp;
+            //an instruction needing a later IU than exists runs in the last
+            id_iu1Reg.execute_inst = min<int>(inst.control.executeStage, exDepth);
 
-            if (tempString[0] == '1') {
+            //a flushed fetch is a nop in every stage
+            id_iu1Reg.idNOP = flushed;
+            id_iu1Reg.exNOP = flushed;
+            id_iu1Reg.memNOP = flushed;
+            id_iu1Reg.wbNOP = flushed;
 
-                tempString.replace(0, 1, "");
-                negativeValue = -1;
+        }
 
-            }
+        //gets register destination, rd in R format and rt in I format
+        if (id_iu1Reg.control & CTRL_REG_DST)
+            id_iu1Reg.regDestination = inst.rd;
+        else
+            id_iu1Reg.regDestination = inst.rt;
 
-            //makes up word difference in address
-            tempConst = stoi(tempString,nullptr,2) * negativeValue;
-            tempConst /= 4;
-            id_iu1Reg.instrutction15_0 = decimalToBinaryStr(tempConst, 16);
+        //forwards values to ID stage, EX latches from ID_IU1 on are older
+        if (POLICY::FORWARDING) {
 
-        } 
-        else {
-            
-            //gets last 16 bits for constant/address
-            id_iu1Reg.instrutction15_0 = if_idReg.fetchedInstruction.substr(16,16);
+            readData1 = forwardValue(forwardSelect(register1, 0), readData1);
+            readData2 = forwardValue(forwardSelect(register2, 0), readData2);
 
         }
 
-        //shifts constant/address to 32 bits
-        while (int(id_iu1Reg.instrutction15_0.size()) != 32)
-                id_iu1Reg.instrutction15_0.insert(1, "0");
+        //constant/address was extended when predecoded
+        id_iu1Reg.instrutction15_0 = inst.instrutction15_0;
 
         //calucates xor
-        int checkZero = stoi(readData1, nullptr, 2) ^ stoi(readData2, nullptr, 2);
+        int32_t checkZero = readData1 ^ readData2;
         
+        bool branchBEQ = id_iu1Reg.control & CTRL_BRANCH_BEQ;
+        bool branchBNE = id_iu1Reg.control & CTRL_BRANCH_BNE;
+        bool jump = id_iu1Reg.control & CTRL_JUMP;
+
         bool zero;
         //checks if result is zero
         if (checkZero == 0)
@@ -1555,18 +4781,18 @@ void instructionDecode(){
         else
             zero = 0;
         
-        //checks for branch or jumping flush
-        if ((id_iu1Reg.branchBEQ && zero) || 
-            (id_iu1Reg.branchBNE && !zero) || id_iu1Reg.jump) {
+        //without a branch stage branches and jumps run as ordinary
+        //instructions, checks for branch or jumping flush
+        if (POLICY::BRANCH_STAGE && ((branchBEQ && zero) || (branchBNE && !zero) || jump)) {
             
             //if jump instruction
-            if (id_iu1Reg.jump)
-                pcSrc = 0;
+            if (jump)
+                pcSrcNext = 0;
             else
-                pcSrc = 1;
+                pcSrcNext = 1;
 
             //flush
-            ifFlush = 1;
+            ifFlushNext = 1;
 
             //nops
             id_iu1Reg.exNOP = 1;
@@ -1575,41 +4801,24 @@ void instructionDecode(){
         
         }
         //checks for branching without flushing
-        else if (id_iu1Reg.branchBEQ || id_iu1Reg.branchBNE) {
+        else if (POLICY::BRANCH_STAGE && (branchBEQ || branchBNE)) {
             
-            pcSrc = 0;
-            ifFlush = 0;
-
             //nops
             id_iu1Reg.exNOP = 1;
             id_iu1Reg.memNOP = 1;
             id_iu1Reg.wbNOP = 1;
 
-        }
-        //normal execution
-        else {
-
-            pcSrc = 0;
-            ifFlush = 0;
-
         }
 
         //checks for branching or jumping (to track clock)
-        if (id_iu1Reg.branchBEQ || id_iu1Reg.branchBNE || id_iu1Reg.jump)
+        if (POLICY::BRANCH_STAGE && (branchBEQ || branchBNE || jump))
             id_iu1Reg.branch_jump = 1;
         else
             id_iu1Reg.branch_jump = 0;
 
-        //fixes address format
-        string address = id_iu1Reg.instrutction15_0;
-        address.replace(0, 1, "");
-
         //jump and conditional addresses
-        int indexAddress = stoi(address , nullptr, 2);
-        id_iu1Reg.nextAddress = indexAddress;
-        id_iu1Reg.jumpAddress = stoi(if_idReg.fetchedInstruction.substr(6, 26), nullptr, 2);
-
-        id_iu1Reg.opcode = opcode;
+        id_iu1Reg.nextAddress = inst.nextAddress;
+        id_iu1Reg.jumpAddress = inst.jumpAddress;
 
         id_iu1Reg.registerRs =  register1;
         id_iu1Reg.registerRt = register2;
@@ -1618,911 +4827,386 @@ void instructionDecode(){
 
     }
 
-    id_iu1Reg.writeFlushed = if_idReg.writeFlushed;
+    id_iu1Reg.writeFlushed = flushed;
 
     //tracks with the right conditions
     if (!hazard_unit.stall && !id_iu1Reg.idNOP)
-        trackIDClock.push_back(clockCycle);
+        trackClock(COLUMN_ID, clockCycle);
     else if (id_iu1Reg.branch_jump || id_iu1Reg.writeFlushed)
-        trackIDClock.push_back(0);
+        trackClock(COLUMN_ID, 0);
 }
 
-void execute_iu1(){
-
-    //hazard
-    hazard_unit.id_iu1MemRead = id_iu1Reg.memRead;
-    hazard_unit.id_iu1RegisterRt = id_iu1Reg.registerRt;
-
-    string registerDes;
+template <class POLICY>
+void Simulator::execute(int stage){
 
-    //gets register destination
-    if (id_iu1Reg.regDst)
-        registerDes = id_iu1Reg.instrutction15_11;
-    else
-        registerDes = id_iu1Reg.instrutction20_16;
+    const EX_LATCH &in = exLatches[stage - 1];
 
-    
-    //forwarding
-    fw_unit.registerRs = id_iu1Reg.registerRs;
-    fw_unit.registerRt = id_iu1Reg.registerRt; 
-    
-    fw_unit.forwardID = 0;
-    forwarding();
+    int registerDes = in.regDestination;
+    int32_t dataA = in.readData1, dataB = in.readData2;
 
-    string dataA, dataB;
+    //forwarding, EX latches after ID_IU1 are older
+    if (stage == 1 && POLICY::FORWARDING) {
 
-    //mux created with forwarding
-    if (fw_unit.forwardA == "010"){
-        dataA = iu2_iu3Reg.aluResult;
-    }
-    else if (fw_unit.forwardA == "011"){
-        dataA = iu1_iu2Reg.aluResult;
-    }
-    else if (fw_unit.forwardA == "100"){
-        dataA = iu3_memReg.aluResult;
-    }
-    else if (fw_unit.forwardA == "001"){
-        dataA = mem_wbReg.muxALU;  
-    }
-    else if (fw_unit.forwardA == "000"){
-        dataA = id_iu1Reg.readData1;
-    }
+        //mux created with forwarding
+        dataA = forwardValue(forwardSelect(in.registerRs, 1), in.readData1);
+        dataB = forwardValue(forwardSelect(in.registerRt, 1), in.readData2);
 
-    if (fw_unit.forwardB == "010"){
-        dataB = iu2_iu3Reg.aluResult;
-    }
-    else if (fw_unit.forwardB == "011"){
-        dataB = iu1_iu2Reg.aluResult;
-    }
-    else if (fw_unit.forwardB == "100"){
-        dataB = iu3_memReg.aluResult;
-    }
-    else if (fw_unit.forwardB == "001"){
-        dataB = mem_wbReg.muxALU;  
     }
-    else if (fw_unit.forwardB == "000"){
-        dataB = id_iu1Reg.readData2;
-    }
-
-    iu1_iu2Reg.regDestination = registerDes;
 
-    if (id_iu1Reg.execute_inst == "01") {
+    bool executes = (in.execute_inst == stage);
+    int32_t getALUResult = 0;
 
-        string getFunct = id_iu1Reg.instrutction15_0.substr(26,6);
+    if (executes) {
 
-        //gets alu control
-        string getAluControl = ALUcontrol(id_iu1Reg.aluOp, getFunct, id_iu1Reg.opcode);
-        string getALUResult;
-        
         //check alusrc and gets result
-        if (id_iu1Reg.aluSrc) {
-            getALUResult = ALU(dataA, id_iu1Reg.instrutction15_0, getAluControl);
-        }
+        if (in.control & CTRL_ALU_SRC) 
+            getALUResult = ALU(dataA, in.instrutction15_0, in.aluOp);
         else 
-            getALUResult = ALU(dataA, dataB, getAluControl);
-
-
-        iu1_iu2Reg.aluResult = getALUResult;
-        iu1_iu2Reg.executed = 1;
-    }
-    else {
-
-        iu1_iu2Reg.executed = id_iu1Reg.executed;
+            getALUResult = ALU(dataA, dataB, in.aluOp);
 
     }
 
+    //last IU passes to the memory stage
+    if (stage == (POLICY::EX_DEPTH ? POLICY::EX_DEPTH : exDepth)) {
 
-    //passes values to next IU
-    iu1_iu2Reg.readData1 = dataA;
-    iu1_iu2Reg.readData2 = dataB;
-
-    iu1_iu2Reg.instrutction15_0 = id_iu1Reg.instrutction15_0;
-    iu1_iu2Reg.opcode = id_iu1Reg.opcode;
-
-    iu1_iu2Reg.nextAddress = id_iu1Reg.nextAddress;
-    iu1_iu2Reg.jumpAddress = id_iu1Reg.jumpAddress;
-
-    //Controls
-    iu1_iu2Reg.aluSrc = id_iu1Reg.aluSrc;
-    iu1_iu2Reg.aluOp = id_iu1Reg.aluOp;
-
-    //passes controls for rest of execution
-    iu1_iu2Reg.memWrite = id_iu1Reg.memWrite;
-    iu1_iu2Reg.memRead = id_iu1Reg.memRead;
-
-    iu1_iu2Reg.regWrite = id_iu1Reg.regWrite;
-    iu1_iu2Reg.memToReg = id_iu1Reg.memToReg;
-
-    //controls for forwarding
-    iu1_iu2Reg.registerRs = id_iu1Reg.registerRs;
-    iu1_iu2Reg.registerRt = id_iu1Reg.registerRt;
-
-    //tracks nops
-    iu1_iu2Reg.exNOP = id_iu1Reg.exNOP;
-    iu1_iu2Reg.memNOP = id_iu1Reg.memNOP;
-    iu1_iu2Reg.wbNOP = id_iu1Reg.wbNOP;
-
-    //tracks flushing
-    iu1_iu2Reg.writeFlushed = id_iu1Reg.writeFlushed;
-
-    //tracks branching and jumping
-    iu1_iu2Reg.branch_jump = id_iu1Reg.branch_jump;
-
-    //indicates IU execution
-    iu1_iu2Reg.execute_inst = id_iu1Reg.execute_inst;
+        if (executes)
+            ex_memNext.aluResult = getALUResult;
+        else
+            ex_memNext.aluResult = in.aluResult;
 
-}
+        ex_memNext.regDestination = registerDes;
+        ex_memNext.readData2 = dataB;
+        
+        //passes controls for rest of execution
+        ex_memNext.control = in.control;
 
-void execute_iu2(){
-    
-    //hazard
-    hazard_unit.iu1_iu2MemRead = iu1_iu2Reg.memRead;
-    hazard_unit.iu1_iu2RegisterRt = iu1_iu2Reg.registerRt;
+        //tracks nops
+        ex_memNext.memNOP = in.memNOP;
+        ex_memNext.wbNOP = in.wbNOP;
 
-    hazard_unit.iu1_iu2RegisterRd = iu1_iu2Reg.regDestination;
-    hazard_unit.iu1_iu2RegWrite = iu1_iu2Reg.regWrite;
+        //tracks flushing
+        ex_memNext.writeFlushed = in.writeFlushed;
 
-    //forwarding
-    fw_unit.iu1_iu2RegisterRd = iu1_iu2Reg.regDestination;
-    fw_unit.iu1_iu2RegWrite = iu1_iu2Reg.regWrite;
+        //tracks branching and jumping
+        ex_memNext.branch_jump = in.branch_jump;
 
-    if (iu1_iu2Reg.execute_inst == "10") {
+        //tracks with the right conditions
+        if (!in.exNOP)
+            trackClock(COLUMN_EX, clockCycle);
+        else if (in.branch_jump || in.writeFlushed)
+            trackClock(COLUMN_EX, 0);
 
-        string getFunct = iu1_iu2Reg.instrutction15_0.substr(26,6);
+        return;
+    }
 
-        //gets alu control
-        string getAluControl = ALUcontrol(iu1_iu2Reg.aluOp, getFunct, iu1_iu2Reg.opcode);
-        string getALUResult;
-        
-        string dataA = iu1_iu2Reg.readData1;
-        string dataB = iu1_iu2Reg.readData2;
-        
-        //check alusrc and gets result
-        if (iu1_iu2Reg.aluSrc) 
-            getALUResult = ALU(dataA, iu1_iu2Reg.instrutction15_0, getAluControl);
+    EX_LATCH &out = exNext[stage];
 
-        else 
-            getALUResult = ALU(dataA, dataB, getAluControl);
+    if (executes) {
 
-        
-        iu2_iu3Reg.aluResult = getALUResult;
-        iu2_iu3Reg.executed = 1;
+        out.aluResult = getALUResult;
+        out.executed = 1;
 
     }
-    else if (iu1_iu2Reg.execute_inst == "01") {
+    //result of an earlier IU is passed on
+    else if (in.execute_inst != 0 && in.execute_inst < stage) {
 
-        iu2_iu3Reg.aluResult = iu1_iu2Reg.aluResult;
-        iu2_iu3Reg.executed = iu1_iu2Reg.executed;
+        out.aluResult = in.aluResult;
+        out.executed = in.executed;
         
     }
     else {
 
-        iu2_iu3Reg.executed = iu1_iu2Reg.executed;
+        out.executed = in.executed;
 
     }
 
     //passes values to next IU
-    iu2_iu3Reg.regDestination = iu1_iu2Reg.regDestination;
+    out.regDestination = registerDes;
 
-    iu2_iu3Reg.readData1 = iu1_iu2Reg.readData1;
-    iu2_iu3Reg.readData2 = iu1_iu2Reg.readData2;
+    out.readData1 = dataA;
+    out.readData2 = dataB;
 
-    iu2_iu3Reg.instrutction15_0 = iu1_iu2Reg.instrutction15_0;
-    iu2_iu3Reg.opcode = iu1_iu2Reg.opcode;
+    out.instrutction15_0 = in.instrutction15_0;
 
-    iu2_iu3Reg.nextAddress = iu1_iu2Reg.nextAddress;
-    iu2_iu3Reg.jumpAddress = iu1_iu2Reg.jumpAddress;
+    out.nextAddress = in.nextAddress;
+    out.jumpAddress = in.jumpAddress;
 
     //Controls
-    iu2_iu3Reg.aluSrc = iu1_iu2Reg.aluSrc;
-    iu2_iu3Reg.aluOp = iu1_iu2Reg.aluOp;
-        
-    //passes controls for rest of execution
-    iu2_iu3Reg.memWrite = iu1_iu2Reg.memWrite;
-    iu2_iu3Reg.memRead = iu1_iu2Reg.memRead;
-
-    iu2_iu3Reg.regWrite = iu1_iu2Reg.regWrite;
-    iu2_iu3Reg.memToReg = iu1_iu2Reg.memToReg;
+    out.control = in.control;
+    out.aluOp = in.aluOp;
 
     //controls for forwarding
-    iu2_iu3Reg.registerRs = iu1_iu2Reg.registerRs;
-    iu2_iu3Reg.registerRt = iu1_iu2Reg.registerRt;
+    out.registerRs = in.registerRs;
+    out.registerRt = in.registerRt;
 
     //tracks nops
-    iu2_iu3Reg.exNOP = iu1_iu2Reg.exNOP;
-    iu2_iu3Reg.memNOP = iu1_iu2Reg.memNOP;
-    iu2_iu3Reg.wbNOP = iu1_iu2Reg.wbNOP;
+    out.exNOP = in.exNOP;
+    out.memNOP = in.memNOP;
+    out.wbNOP = in.wbNOP;
 
     //tracks flushing
-    iu2_iu3Reg.writeFlushed = iu1_iu2Reg.writeFlushed;
+    out.writeFlushed = in.writeFlushed;
 
     //tracks branching and jumping
-    iu2_iu3Reg.branch_jump = iu1_iu2Reg.branch_jump;
+    out.branch_jump = in.branch_jump;
 
     //indicates IU execution
-    iu2_iu3Reg.execute_inst = iu1_iu2Reg.execute_inst;
+    out.execute_inst = in.execute_inst;
 
 }
 
-void execute_iu3(){
-
-    //hazard
-    hazard_unit.iu2_iu3MemRead = iu2_iu3Reg.memRead;
-    hazard_unit.iu2_iu3RegisterRt = iu2_iu3Reg.registerRt;
-
-    hazard_unit.iu2_iu3RegisterRd = iu2_iu3Reg.regDestination;
-    hazard_unit.iu2_iu3RegWrite = iu2_iu3Reg.regWrite;
-
-    //forwarding
-    fw_unit.iu2_iu3RegisterRd = iu2_iu3Reg.regDestination;
-    fw_unit.iu2_iu3RegWrite = iu2_iu3Reg.regWrite;
-
-    if (iu2_iu3Reg.execute_inst == "11") {
+void Simulator::accessMemory(){
 
-        string getFunct = iu2_iu3Reg.instrutction15_0.substr(26,6);
+    uint32_t getAddress = ex_memReg.aluResult;
+    int32_t getWriteData = ex_memReg.readData2;
 
-        //gets alu control
-        string getAluControl = ALUcontrol(iu2_iu3Reg.aluOp, getFunct, iu2_iu3Reg.opcode);
-        string getALUResult;
-        
-        string dataA = iu2_iu3Reg.readData1;
-        string dataB = iu2_iu3Reg.readData2;
-
-        //check alusrc and gets result
-        if (iu2_iu3Reg.aluSrc) 
-            getALUResult = ALU(dataA, iu2_iu3Reg.instrutction15_0, getAluControl);
+    mem_wbNext.readDataMem = 0;
 
-        else 
-            getALUResult = ALU(dataA, dataB, getAluControl);
+    //checks to write to memory
+    if (ex_memReg.control & CTRL_MEM_WRITE) {
 
+        //a sampling window puts memory back afterwards
+        if (sampling)
+            undoStores.push_back(tuple<uint32_t, uint32_t>(getAddress, memory.read(getAddress)));
 
-        iu3_memReg.aluResult = getALUResult;
+        //changes data
+        memory.write(getAddress, getWriteData);
 
-    }
-    else {
+        //page goes in the next incremental checkpoint
+        if (checkpointInterval)
+            dirtyPages.insert(getAddress >> PAGE_BITS);
 
-        iu3_memReg.aluResult = iu2_iu3Reg.aluResult;
-    
     }
 
-    hazard_unit.iu3executed = 1;
-
-    iu3_memReg.regDestination = iu2_iu3Reg.regDestination;
-    iu3_memReg.readData2 = iu2_iu3Reg.readData2;
-    
-    //passes controls for rest of execution
-    iu3_memReg.memWrite = iu2_iu3Reg.memWrite;
-    iu3_memReg.memRead = iu2_iu3Reg.memRead;
-
-    iu3_memReg.regWrite = iu2_iu3Reg.regWrite;
-    iu3_memReg.memToReg = iu2_iu3Reg.memToReg;
-
-    //tracks nops
-    iu3_memReg.memNOP = iu2_iu3Reg.memNOP;
-    iu3_memReg.wbNOP = iu2_iu3Reg.wbNOP;
-
-    //tracks flushing
-    iu3_memReg.writeFlushed = iu2_iu3Reg.writeFlushed;
-
-    //tracks branching and jumping
-    iu3_memReg.branch_jump = iu2_iu3Reg.branch_jump;
-
-    //tracks with the right conditions
-    if (!iu2_iu3Reg.exNOP)
-        trackEXClock.push_back(clockCycle);
-    else if (iu2_iu3Reg.branch_jump || iu2_iu3Reg.writeFlushed)
-        trackEXClock.push_back(0);
-}
-void accessMemory(){
-
-    string getAddress = iu3_memReg.aluResult;
-    string getWriteData = iu3_memReg.readData2;
-
-    mem_wbReg.readDataMem = "";
-
-    //checks to write to memory
-    if (iu3_memReg.memWrite) 
-
-        //changes data, makes up for index at 0x100
-        list_0x100[stoi(getAddress,nullptr,2) - 256] = getWriteData;
-
     //checks to read from address
-    if (iu3_memReg.memRead) {
+    if (ex_memReg.control & CTRL_MEM_READ) {
 
         //passes whats read to mem_wb register
-        mem_wbReg.readDataMem = list_0x100[stoi(getAddress,nullptr,2) - 256];
+        mem_wbNext.readDataMem = memory.read(getAddress);
        
     }
 
     //passes to mem_wb register
-    mem_wbReg.aluResult = iu3_memReg.aluResult;
-    mem_wbReg.regDestination = iu3_memReg.regDestination;
+    mem_wbNext.aluResult = ex_memReg.aluResult;
+    mem_wbNext.regDestination = ex_memReg.regDestination;
 
-    mem_wbReg.regWrite = iu3_memReg.regWrite;
-    mem_wbReg.memToReg = iu3_memReg.memToReg;
+    mem_wbNext.control = ex_memReg.control;
 
-    //forwarding
-    fw_unit.iu3_memRegisterRd = iu3_memReg.regDestination;
-    fw_unit.iu3_memRegWrite = iu3_memReg.regWrite;
-    
     //nops
-    mem_wbReg.wbNOP = iu3_memReg.wbNOP;
+    mem_wbNext.wbNOP = ex_memReg.wbNOP;
 
     //tracks flushing
-    mem_wbReg.writeFlushed = iu3_memReg.writeFlushed;
+    mem_wbNext.writeFlushed = ex_memReg.writeFlushed;
 
     //tracks branch and jumping
-    mem_wbReg.branch_jump = iu3_memReg.branch_jump;
+    mem_wbNext.branch_jump = ex_memReg.branch_jump;
 
     //tracks with the right conditions
-    if (!iu3_memReg.memNOP)
-        trackMEMClock.push_back(clockCycle);
-    else if (iu3_memReg.branch_jump || iu3_memReg.writeFlushed)
-        trackMEMClock.push_back(0);
+    if (!ex_memReg.memNOP)
+        trackClock(COLUMN_MEM, clockCycle);
+    else if (ex_memReg.branch_jump || ex_memReg.writeFlushed)
+        trackClock(COLUMN_MEM, 0);
 }
-void writeBack(){
+void Simulator::writeBack(){
 
-    string writeRegister = mem_wbReg.regDestination;
-    string writeData;
-
-    //forwarding
-    fw_unit.mem_wbRegisterRd = mem_wbReg.regDestination;
-    fw_unit.mem_wbRegWrite = mem_wbReg.regWrite;
-
-    //checks to write register from memory
-    if (mem_wbReg.memToReg) 
-        writeData = mem_wbReg.readDataMem;
-    else
-        writeData = mem_wbReg.aluResult;
-    
-    
-    mem_wbReg.muxALU = writeData;
-    
-    //checks to write to register
-    if (mem_wbReg.regWrite) {
-        
-        int negativeValue = 1;
-        if (writeData[0] == '1') {
-            
-            negativeValue = -1;
-            writeData.replace(0, 1, "");
-        
-        }
+    //checks to write to register, the register file is written when the
+    //clock cycle is committed
+    if (mem_wbReg.control & CTRL_REG_WRITE) {
     
-        //cannot write to $zero
-        if (stoi(writeRegister,nullptr,2) != 0)
-            registers[stoi(writeRegister,nullptr,2)] = stoi(writeData,nullptr,2) * negativeValue;
+        writeRegisterNext = mem_wbReg.regDestination;
+        writeDataNext = writeBackValue(mem_wbReg);
 
     }
 
     //tracks with the right conditions
     if (!mem_wbReg.wbNOP)
-        trackWBClock.push_back(clockCycle);
+        trackClock(COLUMN_WB, clockCycle);
     else if (mem_wbReg.branch_jump || mem_wbReg.writeFlushed)
-        trackWBClock.push_back(0);
-
-    //writes output after stages have been tracked
-    if (mem_wbReg.writeFlushed) {
-
-        writeOutput(instructionFile);
-
-    }
-}
-
-void makeControl(string opcode, string funct){
-
-    //r-type opcode
-    if (opcode == "000000"){
-
-        id_iu1Reg.regDst = 1;
-        id_iu1Reg.aluSrc = 0;
-        id_iu1Reg.memToReg = 0;
-        id_iu1Reg.regWrite = 1;
-        id_iu1Reg.memRead = 0;
-        id_iu1Reg.memWrite = 0;
-        id_iu1Reg.branchBEQ = 0;
-        id_iu1Reg.branchBNE = 0;
-        id_iu1Reg.jump = 0;
-
-        id_iu1Reg.aluOp = "010";
-        
-        //add control
-        if (funct == "100000"){
-            id_iu1Reg.execute_inst = "10";
-        }
-        //subtract control
-        else if (funct == "100010"){
-            id_iu1Reg.execute_inst = "10";
-        }
-        //and control
-        else if (funct == "100100"){
-            id_iu1Reg.execute_inst = "01";
-        }
-        //or control
-        else if (funct == "100101"){
-            id_iu1Reg.execute_inst = "01";
-        }
-        //sll control
-        else if (funct == "000000"){
-            id_iu1Reg.execute_inst = "01";
-        }
-        //srl control
-        else if (funct == "000010"){
-            id_iu1Reg.execute_inst = "01";
-        }
-        //mult control
-        else if (funct == "011000"){
-            id_iu1Reg.execute_inst = "11";
-        }
-
-    }
-    //andi
-    else if (opcode == "001100"){
-
-        id_iu1Reg.regDst = 0;
-        id_iu1Reg.aluSrc = 1;
-        id_iu1Reg.memToReg = 0;
-        id_iu1Reg.regWrite = 1;
-        id_iu1Reg.memRead = 0;
-        id_iu1Reg.memWrite = 0;
-        id_iu1Reg.branchBEQ = 0;
-        id_iu1Reg.branchBNE = 0;
-        id_iu1Reg.jump = 0;
-
-        id_iu1Reg.aluOp = "011";
-        id_iu1Reg.execute_inst = "01";
-    }
-    //ori
-    else if (opcode == "001101"){
-
-        id_iu1Reg.regDst = 0;
-        id_iu1Reg.aluSrc = 1;
-        id_iu1Reg.memToReg = 0;
-        id_iu1Reg.regWrite = 1;
-        id_iu1Reg.memRead = 0;
-        id_iu1Reg.memWrite = 0;
-        id_iu1Reg.branchBEQ = 0;
-        id_iu1Reg.branchBNE = 0;
-        id_iu1Reg.jump = 0;
-
-        id_iu1Reg.aluOp = "011";
-        id_iu1Reg.execute_inst = "01";
-        
-    }
-    //addi opcode
-    else if (opcode == "001000"){
-
-        id_iu1Reg.regDst = 0;
-        id_iu1Reg.aluSrc = 1;
-        id_iu1Reg.memToReg = 0;
-        id_iu1Reg.regWrite = 1;
-        id_iu1Reg.memRead = 0;
-        id_iu1Reg.memWrite = 0;
-        id_iu1Reg.branchBEQ = 0;
-        id_iu1Reg.branchBNE = 0;
-        id_iu1Reg.jump = 0;
-
-        id_iu1Reg.aluOp = "000";
-        id_iu1Reg.execute_inst = "10";
-
-    }
-    //li opcode
-    else if (opcode == "001011"){
-
-        id_iu1Reg.regDst = 0;
-        id_iu1Reg.aluSrc = 1;
-        id_iu1Reg.memToReg = 0;
-        id_iu1Reg.regWrite = 1;
-        id_iu1Reg.memRead = 0;
-        id_iu1Reg.memWrite = 0;
-        id_iu1Reg.branchBEQ = 0;
-        id_iu1Reg.branchBNE = 0;
-        id_iu1Reg.jump = 0;
-
-        id_iu1Reg.aluOp = "000";
-        id_iu1Reg.execute_inst = "01";
-
-    }
-    //subi opcode (made up)
-    else if (opcode == "100001"){
-
-        id_iu1Reg.regDst = 0;
-        id_iu1Reg.aluSrc = 1;
-        id_iu1Reg.memToReg = 0;
-        id_iu1Reg.regWrite = 1;
-        id_iu1Reg.memRead = 0;
-        id_iu1Reg.memWrite = 0;
-        id_iu1Reg.branchBEQ = 0;
-        id_iu1Reg.branchBNE = 0;
-        id_iu1Reg.jump = 0;
-
-        id_iu1Reg.aluOp = "001";
-        id_iu1Reg.execute_inst = "10";
-
-    }
-    //lw opcode
-    else if (opcode == "100011"){
-
-        id_iu1Reg.regDst = 0;
-        id_iu1Reg.aluSrc = 1;
-        id_iu1Reg.memToReg = 1;
-        id_iu1Reg.regWrite = 1;
-        id_iu1Reg.memRead = 1;
-        id_iu1Reg.memWrite = 0;
-        id_iu1Reg.branchBEQ = 0;
-        id_iu1Reg.branchBNE = 0;
-        id_iu1Reg.jump = 0;
-
-        id_iu1Reg.aluOp = "000";
-        id_iu1Reg.execute_inst = "01";
-    }
-    //sw opcode
-    else if (opcode == "101011"){
-
-        id_iu1Reg.regDst = 0;
-        id_iu1Reg.aluSrc = 1;
-        id_iu1Reg.memToReg = 1;
-        id_iu1Reg.regWrite = 0;
-        id_iu1Reg.memRead = 0;
-        id_iu1Reg.memWrite = 1;
-        id_iu1Reg.branchBEQ = 0;
-        id_iu1Reg.branchBNE = 0;
-        id_iu1Reg.jump = 0;
-
-        id_iu1Reg.aluOp = "000";
-        id_iu1Reg.execute_inst = "01";
-    }
-    //slli
-    else if (opcode == "010010"){
-
-        id_iu1Reg.regDst = 0;
-        id_iu1Reg.aluSrc = 1;
-        id_iu1Reg.memToReg = 0;
-        id_iu1Reg.regWrite = 1;
-        id_iu1Reg.memRead = 0;
-        id_iu1Reg.memWrite = 0;
-        id_iu1Reg.branchBEQ = 0;
-        id_iu1Reg.branchBNE = 0;
-        id_iu1Reg.jump = 0;
-
-        id_iu1Reg.aluOp = "100";
-        id_iu1Reg.execute_inst = "01";
-        
-    }
-    //srli
-    else if (opcode == "000011"){
-
-        id_iu1Reg.regDst = 0;
-        id_iu1Reg.aluSrc = 1;
-        id_iu1Reg.memToReg = 0;
-        id_iu1Reg.regWrite = 1;
-        id_iu1Reg.memRead = 0;
-        id_iu1Reg.memWrite = 0;
-        id_iu1Reg.branchBEQ = 0;
-        id_iu1Reg.branchBNE = 0;
-        id_iu1Reg.jump = 0;
-
-        id_iu1Reg.aluOp = "101";
-        id_iu1Reg.execute_inst = "01";
-        
-    }
-    //beq
-    else if (opcode == "000100"){
-
-        id_iu1Reg.regDst = 0;
-        id_iu1Reg.aluSrc = 0;
-        id_iu1Reg.memToReg = 0;
-        id_iu1Reg.regWrite = 0;
-        id_iu1Reg.memRead = 0;
-        id_iu1Reg.memWrite = 0;
-        id_iu1Reg.branchBEQ = 1;
-        id_iu1Reg.branchBNE = 0;
-        id_iu1Reg.jump = 0;
-
-        id_iu1Reg.aluOp = "001";
-        id_iu1Reg.execute_inst = "01";
-
-    }
-    //bne
-    else if (opcode == "000101"){
-        
-        id_iu1Reg.regDst = 0;
-        id_iu1Reg.aluSrc = 0;
-        id_iu1Reg.memToReg = 0;
-        id_iu1Reg.regWrite = 0;
-        id_iu1Reg.memRead = 0;
-        id_iu1Reg.memWrite = 0;
-        id_iu1Reg.branchBEQ = 0;
-        id_iu1Reg.branchBNE = 1;
-        id_iu1Reg.jump = 0;
-
-        id_iu1Reg.aluOp = "001";
-        id_iu1Reg.execute_inst = "01";
-
-    }
-    //j
-    else if (opcode == "000010"){
-
-        id_iu1Reg.regDst = 0;
-        id_iu1Reg.aluSrc = 0;
-        id_iu1Reg.memToReg = 0;
-        id_iu1Reg.regWrite = 0;
-        id_iu1Reg.memRead = 0;
-        id_iu1Reg.memWrite = 0;
-        id_iu1Reg.branchBEQ = 0;
-        id_iu1Reg.branchBNE = 0;
-        id_iu1Reg.jump = 1;
-        
-        id_iu1Reg.aluOp = "000";
-        id_iu1Reg.execute_inst = "01";
-
-    }
-    //multi opcode
-    else if (opcode == "001001"){
-
-        id_iu1Reg.regDst = 0;
-        id_iu1Reg.aluSrc = 1;
-        id_iu1Reg.memToReg = 0;
-        id_iu1Reg.regWrite = 1;
-        id_iu1Reg.memRead = 0;
-        id_iu1Reg.memWrite = 0;
-        id_iu1Reg.branchBEQ = 0;
-        id_iu1Reg.branchBNE = 0;
-        id_iu1Reg.jump = 0;
-
-        id_iu1Reg.aluOp = "111";
-        id_iu1Reg.execute_inst = "11";
-
-    }
-
-
+        trackClock(COLUMN_WB, 0);
 }
 
-string ALU(string var1, string var2, string control){
+int32_t ALU(int32_t var1, int32_t var2, ALU_OP control){
     
-    //converts from binary to int
-    int negativeValue1 = 1;
-    if (var1[0] == '1') {
-
-        var1.replace(0, 1, "");
-        negativeValue1 = -1;
-
-    }
-
-    int negativeValue2 = 1;
-    if (var2[0] == '1') {
-
-        var2.replace(0, 1, "");
-        negativeValue2 = -1;
-
-    }
-
-    int num_var1 = stoi(var1, nullptr, 2) * negativeValue1;
-    int num_var2 = stoi(var2, nullptr, 2) * negativeValue2;
+    //operates on two's complement bits so results wrap like hardware
+    uint32_t num_var1 = uint32_t(var1);
+    uint32_t num_var2 = uint32_t(var2);
 
     //set to zero to prevent code from breaking
-    int result = 0;
+    uint32_t result = 0;
 
     //checks alu control to do alu operation
-    if (control == "0010"){
-        result = num_var1 + num_var2;
-    }
-    else if (control == "0110"){
-        result = num_var1 - num_var2;
-    }
-    else if (control == "0000"){
-        result = num_var1 & num_var2;
-    }
-    else if (control == "0001"){
-        result = num_var1 | num_var2;
-    }
-    else if (control == "1111"){  
-        result = num_var1 << num_var2;
-    }
-    else if (control == "1001"){   
-        result = num_var1 >> num_var2;
-    }
-    else if (control == "1000"){   
-        result = num_var1 * num_var2;
-    }
-
-    string makeResult;
-    if (result < 0){
-
-        makeResult = "1";
-        result *= -1;
-
-    }
-    else {
-
-        makeResult = "0";
+    switch (control){
+
+        case ALU_ADD:
+            result = num_var1 + num_var2;
+            break;
+        case ALU_SUB:
+            result = num_var1 - num_var2;
+            break;
+        case ALU_AND:
+            result = num_var1 & num_var2;
+            break;
+        case ALU_OR:
+            result = num_var1 | num_var2;
+            break;
+        case ALU_SLL:
+            result = num_var1 << (num_var2 & 0x1F);
+            break;
+        case ALU_SRL:
+            result = num_var1 >> (num_var2 & 0x1F);
+            break;
+        case ALU_MULT:
+            result = num_var1 * num_var2;
+            break;
 
     }
 
-    makeResult.append(decimalToBinaryStr(result, 31));
-
     //returns a 32 bit answer
-    return makeResult;
+    return int32_t(result);
 }
 
-string ALUcontrol(string aluOp, string funct, string opcode){
-
-    //r-type instruction
-    if (aluOp == "010"){
-        
-        //add control
-        if (funct == "100000"){
-            return "0010";
-        }
-        //subtract control
-        else if (funct == "100010"){
-            return "0110";
-        }
-        //and control
-        else if (funct == "100100"){
-            return "0000";
-        }
-        //or control
-        else if (funct == "100101"){
-            return "0001";
-        }
-        //sll control
-        else if (funct == "000000"){
-            //custom control
-            return "1111";
-        }
-        //srl control
-        else if (funct == "000010"){
-            //custom control
-            return "1001";
-        }
-        //mult control
-        else if (funct == "011000"){
-            return "1000";
-        }
-        
-    }
-    //lw, sw, li, and addi control
-    else if (aluOp == "000") {
-        return "0010";
-    }
-    //subi, beq, bne control
-    else if (aluOp == "001"){
-        return "0110";
-    }
-    //made up for andi and ori
-    else if (aluOp == "011"){
+LANE_KERNEL
+void laneALU(LANE_WORDS &dest, const LANE_WORDS &var1, const LANE_WORDS &var2
+                , const LANE_WORDS &mask, ALU_OP control){
+
+    //results are built apart from dest so dest can also be an operand
+    uint32_t result[LOCKSTEP_LANES];
+
+    //one loop per operation so each is a plain vector loop, operates on
+    //two's complement bits like ALU
+    switch (control){
+
+        case ALU_ADD:
+            for (int lane = 0; lane < LOCKSTEP_LANES; lane++)
+                result[lane] = uint32_t(var1[lane]) + uint32_t(var2[lane]);
+            break;
+        case ALU_SUB:
+            for (int lane = 0; lane < LOCKSTEP_LANES; lane++)
+                result[lane] = uint32_t(var1[lane]) - uint32_t(var2[lane]);
+            break;
+        case ALU_AND:
+            for (int lane = 0; lane < LOCKSTEP_LANES; lane++)
+                result[lane] = uint32_t(var1[lane]) & uint32_t(var2[lane]);
+            break;
+        case ALU_OR:
+            for (int lane = 0; lane < LOCKSTEP_LANES; lane++)
+                result[lane] = uint32_t(var1[lane]) | uint32_t(var2[lane]);
+            break;
+        case ALU_SLL:
+            for (int lane = 0; lane < LOCKSTEP_LANES; lane++)
+                result[lane] = uint32_t(var1[lane]) << (var2[lane] & 0x1F);
+            break;
+        case ALU_SRL:
+            for (int lane = 0; lane < LOCKSTEP_LANES; lane++)
+                result[lane] = uint32_t(var1[lane]) >> (var2[lane] & 0x1F);
+            break;
+        case ALU_MULT:
+            for (int lane = 0; lane < LOCKSTEP_LANES; lane++)
+                result[lane] = uint32_t(var1[lane]) * uint32_t(var2[lane]);
+            break;
 
-        //andi
-        if (opcode == "001100")
-            return "0000";
-        //ori
-        if (opcode == "001101")
-            return "0001";
-        
-    }
-    //slli
-    else if (aluOp == "100"){
-        return "1111";
-    }
-    //srli
-    else if (aluOp == "101"){
-        return "1001";
-    }
-    //multi
-    else if (aluOp == "111"){
-        return "1000";
     }
 
+    for (int lane = 0; lane < LOCKSTEP_LANES; lane++)
+        dest[lane] = (int32_t(result[lane]) & mask[lane]) | (dest[lane] & ~mask[lane]);
 
-    //incase breaks
-    return "0000";
 }
 
+LANE_KERNEL
+void laneSelect(LANE_WORDS &dest, const LANE_WORDS &value, const LANE_WORDS &mask){
 
-void forwarding(){
+    for (int lane = 0; lane < LOCKSTEP_LANES; lane++)
+        dest[lane] = (value[lane] & mask[lane]) | (dest[lane] & ~mask[lane]);
 
-    //ForwardA dectection
-    if (fw_unit.mem_wbRegWrite && (fw_unit.mem_wbRegisterRd != "00000")
-        && !((fw_unit.iu2_iu3RegWrite && (fw_unit.iu2_iu3RegisterRd != "00000")
-        && (fw_unit.iu2_iu3RegisterRd == fw_unit.registerRs)) 
-        || (fw_unit.iu1_iu2RegWrite && (fw_unit.iu1_iu2RegisterRd != "00000")
-        && (fw_unit.iu1_iu2RegisterRd == fw_unit.registerRs))
-        || (fw_unit.iu3_memRegWrite && (fw_unit.iu3_memRegisterRd != "00000")
-        && (fw_unit.iu3_memRegisterRd == fw_unit.registerRs)))
-        && (fw_unit.mem_wbRegisterRd == fw_unit.registerRs)){
+}
 
-        fw_unit.forwardA = "001";
+FORWARD_SELECT Simulator::forwardSelect(int reg, int firstLatch) const{
 
-    }
-    else if (fw_unit.iu2_iu3RegWrite && (fw_unit.iu2_iu3RegisterRd != "00000")
-        && (fw_unit.iu2_iu3RegisterRd == fw_unit.registerRs)) {
+    uint32_t bit = uint32_t(1) << reg;
+    FORWARD_SELECT select;
 
-        fw_unit.forwardA = "010";
+    //the newest write of the register is forwarded, the hazard unit stalls
+    //until its latch holds the result
+    for (int latch = firstLatch; latch < exDepth; latch++) {
 
-    }
-    else if (fw_unit.iu1_iu2RegWrite && (fw_unit.iu1_iu2RegisterRd != "00000")
-        && (fw_unit.iu1_iu2RegisterRd == fw_unit.registerRs) && fw_unit.forwardID){
-        
-        fw_unit.forwardA = "011";
+        if (fw_unit.exWrites[latch] & bit) {
 
-    }
-    else if (fw_unit.iu3_memRegWrite && (fw_unit.iu3_memRegisterRd != "00000")
-        && (fw_unit.iu3_memRegisterRd == fw_unit.registerRs)){
+            if (fw_unit.exReady[latch] & bit) {
 
-        fw_unit.forwardA = "100";
+                select.source = FORWARD_EX_LATCH;
+                select.latch = latch;
 
-    }
-    else {
+            }
 
-        fw_unit.forwardA = "000";
+            return select;
 
+        }
     }
 
-    //ForwardB dectection
-    if (fw_unit.mem_wbRegWrite && (fw_unit.mem_wbRegisterRd != "00000")
-        && !((fw_unit.iu2_iu3RegWrite && (fw_unit.iu2_iu3RegisterRd != "00000")
-        && (fw_unit.iu2_iu3RegisterRd == fw_unit.registerRt)) 
-        || (fw_unit.iu1_iu2RegWrite && (fw_unit.iu1_iu2RegisterRd != "00000")
-        && (fw_unit.iu1_iu2RegisterRd == fw_unit.registerRt))
-        || (fw_unit.iu3_memRegWrite && (fw_unit.iu3_memRegisterRd != "00000")
-        && (fw_unit.iu3_memRegisterRd == fw_unit.registerRt)))
-        && (fw_unit.mem_wbRegisterRd == fw_unit.registerRt)){
+    if (fw_unit.ex_memWrites & bit) {
 
-        fw_unit.forwardB = "001";
+        if (fw_unit.ex_memReady & bit)
+            select.source = FORWARD_EX_MEM;
 
     }
-    else if (fw_unit.iu2_iu3RegWrite && (fw_unit.iu2_iu3RegisterRd != "00000")
-        && (fw_unit.iu2_iu3RegisterRd == fw_unit.registerRt)) {
+    else if (fw_unit.mem_wbWrites & bit) {
 
-        fw_unit.forwardB = "010";
+        select.source = FORWARD_MEM_WB;
 
     }
-    else if (fw_unit.iu1_iu2RegWrite && (fw_unit.iu1_iu2RegisterRd != "00000")
-        && (fw_unit.iu1_iu2RegisterRd == fw_unit.registerRt) && fw_unit.forwardID){
-        
-        fw_unit.forwardB = "011";
 
-    }
-    else if (fw_unit.iu3_memRegWrite && (fw_unit.iu3_memRegisterRd != "00000")
-        && (fw_unit.iu3_memRegisterRd == fw_unit.registerRt)){
+    return select;
+}
 
-        fw_unit.forwardB = "100";
+int32_t Simulator::forwardValue(FORWARD_SELECT select, int32_t readData) const{
 
-    }
-    else {
+    switch (select.source) {
 
-        fw_unit.forwardB = "000";
+        case FORWARD_MEM_WB:
+            return writeBackValue(mem_wbReg);
+        case FORWARD_EX_MEM:
+            return ex_memReg.aluResult;
+        case FORWARD_EX_LATCH:
+            return exLatches[select.latch].aluResult;
+        case FORWARD_NONE:
+            break;
 
     }
 
+    return readData;
 }
 
+int32_t Simulator::readRegister(int reg) const{
 
-void hazardDetection(){
+    //write back writes the register file in the first half of the clock
+    //cycle, before ID reads it
+    if (reg != 0 && (mem_wbReg.control & CTRL_REG_WRITE) && mem_wbReg.regDestination == reg)
+        return writeBackValue(mem_wbReg);
 
-    //load use detection and forward detection, stalls here
-    if ((hazard_unit.id_iu1MemRead && ((hazard_unit.id_iu1RegisterRt == hazard_unit.if_idRegisterRs) || 
-        (hazard_unit.id_iu1RegisterRt == hazard_unit.if_idRegisterRt))) || 
-        (hazard_unit.iu1_iu2MemRead && ((hazard_unit.iu1_iu2RegisterRt == hazard_unit.if_idRegisterRs) || 
-        (hazard_unit.iu1_iu2RegisterRt == hazard_unit.if_idRegisterRt))) || 
-        (hazard_unit.iu2_iu3MemRead && ((hazard_unit.iu2_iu3RegisterRt == hazard_unit.if_idRegisterRs) || 
-        (hazard_unit.iu2_iu3RegisterRt == hazard_unit.if_idRegisterRt)))){
+    return registers[reg];
+}
 
-        hazard_unit.stall = 1;
-        hazard_unit.PCWrite = 0;
-    }
-    else if (hazard_unit.iu1_iu2RegWrite && (hazard_unit.iu1_iu2RegisterRd != "00000")
-        && ((hazard_unit.iu1_iu2RegisterRd == hazard_unit.if_idRegisterRt) 
-        || (hazard_unit.iu1_iu2RegisterRd == hazard_unit.if_idRegisterRs)) && (!hazard_unit.iu1executed)) {
+template <class POLICY>
+void Simulator::hazardDetection(){
 
-        hazard_unit.stall = 1;
-        hazard_unit.PCWrite = 0;
+    const DECODED_INST &inst = *if_idReg.fetchedInstruction;
+    uint16_t control = inst.control.control;
 
-    }
-    else if (hazard_unit.iu2_iu3RegWrite && (hazard_unit.iu2_iu3RegisterRd != "00000")
-        && ((hazard_unit.iu2_iu3RegisterRd == hazard_unit.if_idRegisterRt) 
-        || (hazard_unit.iu2_iu3RegisterRd == hazard_unit.if_idRegisterRs)) && (!hazard_unit.iu2executed)){
+    //registers read by the decoded instruction, a flushed fetch, halt or jump
+    //reads none
+    uint32_t reads = 0;
+
+    if (!ifFlush && !inst.halt && !(control & CTRL_JUMP))
+        reads = (uint32_t(1) << inst.rs) | (uint32_t(1) << inst.rt);
+
+    //branches compare in ID, the rest need their operands in IU1
+    uint32_t pending = hazard_unit.pendingNext;
+
+    if (POLICY::BRANCH_STAGE == DECODE && (control & (CTRL_BRANCH_BEQ | CTRL_BRANCH_BNE)))
+        pending = hazard_unit.pendingNow;
+
+    //stalls until forwarding covers the registers read
+    if (reads & pending) {
 
         hazard_unit.stall = 1;
         hazard_unit.PCWrite = 0;
@@ -2534,5 +5218,4 @@ void hazardDetection(){
         hazard_unit.PCWrite = 1;
 
     }
-
 }
\ No newline at end of file
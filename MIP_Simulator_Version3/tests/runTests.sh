@@ -0,0 +1,174 @@
+#!/bin/sh
+#Checks of the simulator on the example programs, run from the project
+#directory: sh tests/runTests.sh <simulator>
+
+simulator=$(cd "$(dirname "$1")" && pwd)/$(basename "$1")
+project=$(pwd)
+failed=0
+
+#runs write register.txt and dataUpdate.txt to the working directory
+work=$(mktemp -d)
+cd "$work" || exit 1
+
+#Precondition:     expected.txt and actual.txt hold the files of two runs
+#Post condition:   Reports the check as failed when they differ or the first
+#                  run wrote nothing
+compare(){
+
+    if [ ! -s expected.txt ] || ! cmp -s expected.txt actual.txt; then
+
+        echo "FAILED $*"
+        failed=1
+
+    fi
+}
+
+#stages only read the pipline registers the clock cycle started with, the
+#order they are called in cannot change a run
+for program in "$project"/Example*.txt; do
+
+    for options in "-version 1" "-version 2" "-ex 1" "-ex 3" "-ex 8"; do
+
+        "$simulator" $options "$program" "$project/data.txt" output.txt > /dev/null
+        cat output.txt register.txt dataUpdate.txt > expected.txt
+
+        for seed in 1 2 3; do
+
+            "$simulator" -shuffle $seed $options "$program" "$project/data.txt" output.txt > /dev/null
+            cat output.txt register.txt dataUpdate.txt > actual.txt
+
+            compare "stage order: -shuffle $seed $options $(basename "$program")"
+
+        done
+    done
+done
+
+#every execute depth has to leave the registers and data the functional mode
+#does, also when a branch goes past the last instruction
+for program in "$project"/Example*.txt "$project/tests/pastEnd.txt"; do
+
+    "$simulator" -functional "$program" "$project/data.txt" > /dev/null
+    cat register.txt dataUpdate.txt > expected.txt
+
+    for options in "-version 2" "-ex 1" "-ex 2" "-ex 3" "-ex 4" "-ex 5" "-ex 6" "-ex 7" "-ex 8"; do
+
+        rm -f register.txt dataUpdate.txt
+        "$simulator" $options "$program" "$project/data.txt" output.txt > /dev/null
+        cat register.txt dataUpdate.txt > actual.txt 2> /dev/null
+
+        compare "execute depth: $options $(basename "$program") against -functional"
+
+    done
+done
+
+#lockstep contexts have to end like the functional mode, also when memory
+#outside the data file is used
+printf '%s lane0_\n%s lane1_\n' "$project/data.txt" "$project/data.txt" > manifest.txt
+
+for program in "$project"/Example*.txt "$project/tests/pastData.txt"; do
+
+    "$simulator" -functional "$program" "$project/data.txt" > /dev/null
+    cat register.txt dataUpdate.txt > expected.txt
+
+    rm -f lane0_* lane1_*
+    "$simulator" -lockstep "$program" manifest.txt > /dev/null
+
+    for lane in lane0_ lane1_; do
+
+        cat ${lane}register.txt ${lane}dataUpdate.txt > actual.txt 2> /dev/null
+        compare "lockstep: $(basename "$program") context $lane against -functional"
+
+    done
+done
+
+#branches go to their label even when the label reads as a hex constant,
+#and a NOP without operands does not take the next line with it, $s1 ends
+#as 3 and $s2 as 5
+printf '%%17 = %032d\n%%18 = %032d\n' 11 101 > expected.txt
+
+for options in "-functional" "-version 2" "-ex 1" "-ex 3" "-ex 8"; do
+
+    rm -f register.txt
+
+    if [ "$options" = "-functional" ]; then
+        "$simulator" $options "$project/tests/labels.txt" "$project/data.txt" > /dev/null
+    else
+        "$simulator" $options "$project/tests/labels.txt" "$project/data.txt" output.txt > /dev/null
+    fi
+
+    grep '^%1[78] ' register.txt > actual.txt 2> /dev/null
+    compare "labels: $options labels.txt"
+
+done
+
+#a run restored from a checkpoint file cut short in the middle of a record
+#has to carry on to the output, registers, data and checkpoint file of a run
+#that was never stopped
+for program in "$project/Example2V3.txt" "$project/tests/labels.txt"; do
+
+    for options in "-version 2" "-ex 1" "-ex 4"; do
+
+        rm -f full.ckpt
+        "$simulator" $options -checkpoint full.ckpt 3 "$program" "$project/data.txt" output.txt > /dev/null
+        cat output.txt register.txt dataUpdate.txt full.ckpt > expected.txt
+
+        size=$(wc -c < full.ckpt)
+
+        #the first record holds every memory page, cuts in the second half
+        #leave it whole
+        for cut in $((size / 2)) $((size - 5)); do
+
+            head -c $cut full.ckpt > cut.ckpt
+            cp output.txt cut.txt
+
+            rm -f register.txt dataUpdate.txt
+            "$simulator" $options -restore cut.ckpt -checkpoint cut.ckpt 3 "$program" "$project/data.txt" cut.txt > /dev/null
+            cat cut.txt register.txt dataUpdate.txt cut.ckpt > actual.txt 2> /dev/null
+
+            compare "checkpoint: $options $(basename "$program") restored from $cut of $size bytes"
+
+        done
+    done
+done
+
+#a binary trace rendered back to text has to be the text output byte for
+#byte, also when the binary run was restored from a checkpoint
+for program in "$project"/Example*V3.txt "$project/tests/labels.txt"; do
+
+    for options in "-version 1" "-version 2" "-ex 1" "-ex 3" "-ex 8"; do
+
+        "$simulator" $options "$program" "$project/data.txt" expected.txt > /dev/null
+
+        rm -f actual.txt
+        "$simulator" $options -binary "$program" "$project/data.txt" trace.bin > /dev/null
+        "$simulator" -render trace.bin actual.txt > /dev/null
+
+        compare "binary trace: $options $(basename "$program") rendered"
+
+        rm -f full.ckpt actual.txt
+        "$simulator" $options -binary -checkpoint full.ckpt 3 "$program" "$project/data.txt" trace.bin > /dev/null
+
+        size=$(wc -c < full.ckpt)
+        head -c $((size - 5)) full.ckpt > cut.ckpt
+
+        #the trace of the whole run is already there, a restore that fails
+        #must not pass
+        "$simulator" $options -binary -restore cut.ckpt "$program" "$project/data.txt" trace.bin > log.txt
+
+        if ! grep -q '^Error' log.txt; then
+            "$simulator" -render trace.bin actual.txt > /dev/null
+        fi
+
+        compare "binary trace: $options $(basename "$program") restored and rendered"
+
+    done
+done
+
+cd "$project"
+rm -rf "$work"
+
+if [ $failed = 0 ]; then
+    echo "All checks passed"
+fi
+
+exit $failed